@@ -14,6 +14,7 @@
 
 void AT_init(void);
 void AT_task(void);
+void AT_scan_task(void);
 void AT_print_rs485_reply(char_t* rs485_reply);
 void AT_print_rs485_frame(char_t* rs485_frame, uint8_t rs485_frame_size);
 void AT_fill_rx_buffer(uint8_t rx_byte);
@@ -0,0 +1,21 @@
+/*
+ * bin.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __BIN_H__
+#define __BIN_H__
+
+#include "types.h"
+
+/*** BIN functions ***/
+
+void BIN_enable(void);
+uint8_t BIN_is_enabled(void);
+void BIN_task(void);
+void BIN_send_rs485_frame(char_t* rs485_frame, uint8_t rs485_frame_size);
+void BIN_fill_rx_buffer(uint8_t rx_byte);
+
+#endif /* __BIN_H__ */
@@ -20,5 +20,6 @@ typedef enum {
 
 void CONFIG_init(void);
 CONFIG_tx_mode_t CONFIG_get_tx_mode(void);
+void CONFIG_update_tx_mode(void);
 
 #endif /* __CONFIG_H__ */
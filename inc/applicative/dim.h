@@ -9,12 +9,40 @@
 #define __DIM_H__
 
 #include "dinfox.h"
+#include "error.h"
+#include "string.h"
+#include "types.h"
+
+/*** DIM structures ***/
 
 typedef enum {
 	DIM_REGISTER_VUSB_MV = DINFOX_REGISTER_LAST,
 	DIM_REGISTER_VRS_MV,
 	DIM_REGISTER_RS485_MODE,
+	DIM_REGISTER_USART_TX_HIGH_WATER_MARK,
+	DIM_REGISTER_USART_TX_DROPPED_BYTES,
+	DIM_REGISTER_ADC_DATA_MAX_AGE_S,
+	DIM_REGISTER_ADC_DATA_AGE_MS,
+	DIM_REGISTER_RS485_BAUD_RATE,
+	DIM_REGISTER_HOST_BAUD_RATE,
+	DIM_REGISTER_USART_RX_OVERRUNS,
+	DIM_REGISTER_RS485_STATISTICS_ADDRESS,
+	DIM_REGISTER_RS485_RX_FRAMES,
+	DIM_REGISTER_RS485_RX_BYTES,
+	DIM_REGISTER_RS485_RX_OVERRUNS,
+	DIM_REGISTER_RS485_RX_TRUNCATED_FRAMES,
+	DIM_REGISTER_RS485_RX_DROPPED_FRAMES,
+	DIM_REGISTER_RS485_REPLY_TIMEOUTS,
+	DIM_REGISTER_RS485_ADDRESS_MISMATCHES,
+	DIM_REGISTER_RS485_ERROR_REPLIES,
 	DIM_REGISTER_LAST,
 } DIM_register_address_t;
 
+/*** DIM functions ***/
+
+STRING_format_t DIM_get_register_format(uint8_t register_address);
+ERROR_t DIM_read_register(uint8_t register_address, int32_t* register_value);
+ERROR_t DIM_read_registers(uint8_t* register_addresses, uint8_t number_of_registers, int32_t* register_values, ERROR_t* register_status);
+ERROR_t DIM_write_register(uint8_t register_address, int32_t register_value);
+
 #endif /* __DIM_H__ */
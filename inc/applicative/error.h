@@ -26,6 +26,8 @@
 #include "types.h"
 // Components.
 #include "rs485.h"
+// Applicative.
+#include "node.h"
 
 /*** ERROR structures ***/
 
@@ -36,6 +38,12 @@ typedef enum {
 	ERROR_RS485_ADDRESS,
 	ERROR_BUSY_SPY_RUNNING,
 	ERROR_TX_DISABLED,
+	ERROR_NULL_PARAMETER,
+	ERROR_BIN_CRC,
+	ERROR_REPLY_OVERFLOW,
+	ERROR_COMMAND_OVERFLOW,
+	ERROR_BUSY_SCAN_RUNNING,
+	ERROR_BENCH_COUNT,
 	// Peripherals.
 	ERROR_BASE_ADC1 = 0x0100,
 	ERROR_BASE_FLASH = (ERROR_BASE_ADC1 + ADC_ERROR_BASE_LAST),
@@ -53,8 +61,10 @@ typedef enum {
 	ERROR_BASE_STRING = (ERROR_BASE_PARSER + PARSER_ERROR_BASE_LAST),
 	// Components.
 	ERROR_BASE_RS485 = (ERROR_BASE_STRING + STRING_ERROR_BASE_LAST),
+	// Applicative.
+	ERROR_BASE_NODE = (ERROR_BASE_RS485 + RS485_ERROR_BASE_LAST),
 	// Last index.
-	ERROR_BASE_LAST = (ERROR_BASE_RS485 + RS485_ERROR_BASE_LAST)
+	ERROR_BASE_LAST = (ERROR_BASE_NODE + NODE_ERROR_BASE_LAST)
 } ERROR_t;
 
 /*** ERROR functions ***/
@@ -0,0 +1,53 @@
+/*
+ * node.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __NODE_H__
+#define __NODE_H__
+
+#include "nvm.h"
+#include "rs485.h"
+#include "rs485_common.h"
+#include "types.h"
+
+/*** NODE macros ***/
+
+#define NODE_LIST_SIZE		16
+
+/*** NODE structures ***/
+
+typedef enum {
+	NODE_SUCCESS = 0,
+	NODE_ERROR_NULL_PARAMETER,
+	NODE_ERROR_INDEX,
+	NODE_ERROR_BASE_NVM = 0x0100,
+	NODE_ERROR_BASE_RS485 = (NODE_ERROR_BASE_NVM + NVM_ERROR_BASE_LAST),
+	NODE_ERROR_BASE_LAST = (NODE_ERROR_BASE_RS485 + RS485_ERROR_BASE_LAST)
+} NODE_status_t;
+
+typedef struct {
+	RS485_node_t node;
+	uint8_t seen_flag; // Node replied since boot.
+	uint32_t last_seen_ms; // RTC time of the last reply (valid if seen flag is set).
+	uint8_t miss_count; // Consecutive rescans without reply.
+} NODE_t;
+
+/*** NODE functions ***/
+
+NODE_status_t NODE_init(void);
+NODE_status_t NODE_scan(RS485_address_t first_address, RS485_address_t last_address);
+NODE_status_t NODE_start_scan(RS485_address_t first_address, RS485_address_t last_address);
+NODE_status_t NODE_scan_step(void);
+uint8_t NODE_is_scan_running(void);
+NODE_status_t NODE_rescan(void);
+uint8_t NODE_get_count(void);
+NODE_status_t NODE_get(uint8_t node_index, NODE_t* node);
+
+#define NODE_status_check(error_base) { if (node_status != NODE_SUCCESS) { status = error_base + node_status; goto errors; }}
+#define NODE_error_check() { ERROR_status_check(node_status, NODE_SUCCESS, ERROR_BASE_NODE); }
+#define NODE_error_check_print() { ERROR_status_check_print(node_status, NODE_SUCCESS, ERROR_BASE_NODE); }
+
+#endif /* __NODE_H__ */
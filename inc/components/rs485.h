@@ -13,6 +13,10 @@
 #include "parser.h"
 #include "rs485_common.h"
 
+/*** RS485 macros ***/
+
+#define RS485_STATISTICS_BUS	0xFF // Statistics address used to select bus-wide counters.
+
 /*** RS485 structures ***/
 
 typedef enum {
@@ -25,18 +29,53 @@ typedef enum {
 	RS485_ERROR_SEQUENCE_TIMEOUT,
 	RS485_ERROR_BUFFER_OVERFLOW,
 	RS485_ERROR_SOURCE_ADDRESS_MISMATCH,
+	RS485_ERROR_ADDRESS_RANGE,
+	RS485_ERROR_TX_TIMEOUT,
 	RS485_ERROR_BASE_LPUART = 0x0100,
 	RS485_ERROR_BASE_LPTIM = (RS485_ERROR_BASE_LPUART + LPUART_ERROR_BASE_LAST),
 	RS485_ERROR_BASE_PARSER = (RS485_ERROR_BASE_LPTIM + LPTIM_ERROR_BASE_LAST),
 	RS485_ERROR_BASE_LAST = (RS485_ERROR_BASE_PARSER + PARSER_ERROR_BASE_LAST)
 } RS485_status_t;
 
+typedef enum {
+	RS485_REPLY_STATUS_OK = 0,
+	RS485_REPLY_STATUS_ERROR,
+	RS485_REPLY_STATUS_VALUE,
+	RS485_REPLY_STATUS_RAW,
+	RS485_REPLY_STATUS_LAST
+} RS485_reply_status_t;
+
+typedef struct {
+	char_t* reply; // Reply data without address header (valid until the next RS485 reception processing).
+	uint8_t reply_size;
+	RS485_reply_status_t reply_status;
+	int32_t value; // For value status.
+	uint32_t reply_time_ms; // Time between end of transmission and reception of the reply.
+} RS485_transaction_t;
+
+typedef struct {
+	uint32_t rx_frames;
+	uint32_t rx_bytes;
+	uint32_t rx_overruns; // Bus-wide only.
+	uint32_t rx_truncated_frames;
+	uint32_t rx_dropped_frames; // Bus-wide only (includes truncated frames).
+	uint32_t reply_timeouts;
+	uint32_t address_mismatches;
+	uint32_t error_replies;
+} RS485_statistics_t;
+
 /*** RS485 functions ***/
 void RS485_init(void);
 RS485_status_t RS485_set_mode(RS485_mode_t mode);
+RS485_mode_t RS485_get_mode(void);
 RS485_status_t RS485_send_command(uint8_t slave_address, char_t* command);
-RS485_status_t RS485_scan_nodes(RS485_node_t* nodes_list, uint8_t node_list_size, uint8_t* number_of_nodes_found);
+RS485_status_t RS485_send_transaction(uint8_t slave_address, char_t* command, RS485_transaction_t* transaction);
+RS485_status_t RS485_scan_nodes(RS485_address_t first_address, RS485_address_t last_address, RS485_node_t* nodes_list, uint8_t node_list_size, uint8_t* number_of_nodes_found);
 void RS485_task(void);
+uint32_t RS485_get_rx_dropped_frames(void);
+RS485_status_t RS485_get_statistics(uint8_t address, RS485_statistics_t* statistics);
+void RS485_reset_statistics(void);
+void RS485_tx_complete(void);
 void RS485_fill_rx_buffer(uint8_t rx_byte);
 
 #define RS485_status_check(error_base) { if (rs485_status != RS485_SUCCESS) { status = error_base + rs485_status; goto errors; }}
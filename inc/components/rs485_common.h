@@ -38,6 +38,7 @@ typedef enum {
 typedef struct {
 	uint8_t address;
 	uint8_t board_id;
+	uint16_t reply_time_ms;
 } RS485_node_t;
 
 #endif /* __RS485_COMMON_H__ */
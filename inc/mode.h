@@ -12,4 +12,20 @@
 
 //#define DEBUG		// Keep programming pins and disable watchdog.
 
+/*** ADC filtering mode ***/
+
+//#define ADC_USE_HW_OVERSAMPLING	// Use ADC hardware oversampler instead of software median filter.
+
+/*** Host link flow control ***/
+
+//#define USART_USE_XON_XOFF		// Software flow control on USART2 (not compatible with binary protocol).
+
+/*** Power measurement mode ***/
+
+//#define PWR_STATISTICS			// Measure time spent in run, sleep and stop modes (AT$PWR? command).
+
+/*** Profiling mode ***/
+
+//#define PROFILING				// Measure hot paths duration in core clock cycles with SysTick (AT$PROF? command).
+
 #endif /* __MODE_H__ */
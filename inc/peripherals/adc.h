@@ -12,6 +12,11 @@
 #include "math.h"
 #include "types.h"
 
+/*** ADC macros ***/
+
+// Maximum age of cached data (1 hour, must be lower than the RTC day to compute ages).
+#define ADC_DATA_MAX_AGE_MAX_S	3600
+
 /*** ADC structures ***/
 
 typedef enum {
@@ -21,6 +26,8 @@ typedef enum {
 	ADC_ERROR_CHANNEL,
 	ADC_ERROR_TIMEOUT,
 	ADC_ERROR_DATA_INDEX,
+	ADC_ERROR_DATA_INVALID,
+	ADC_ERROR_DATA_MAX_AGE,
 	ADC_ERROR_BASE_LPTIM = 0x0100,
 	ADC_ERROR_BASE_MATH = (ADC_ERROR_BASE_LPTIM + LPTIM_ERROR_BASE_LAST),
 	ADC_ERROR_BASE_LAST = (ADC_ERROR_BASE_MATH + MATH_ERROR_BASE_LAST)
@@ -37,6 +44,10 @@ typedef enum {
 
 ADC_status_t ADC1_init(void);
 ADC_status_t ADC1_perform_measurements(void);
+ADC_status_t ADC1_update_data(uint32_t anticipation_ms);
+ADC_status_t ADC1_set_data_max_age(uint32_t max_age_s);
+uint32_t ADC1_get_data_max_age(void);
+ADC_status_t ADC1_get_data_age(uint32_t* data_age_ms);
 ADC_status_t ADC1_get_data(ADC_data_index_t data_idx, uint32_t* data);
 ADC_status_t ADC1_get_tmcu(int8_t* tmcu_degrees);
 
@@ -0,0 +1,33 @@
+/*
+ * dma.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __DMA_H__
+#define __DMA_H__
+
+#include "types.h"
+
+/*** DMA functions ***/
+
+void DMA1_CH1_init(void);
+void DMA1_CH1_set_destination_address(uint32_t destination_buffer_address, uint16_t destination_buffer_size);
+void DMA1_CH1_start(void);
+void DMA1_CH1_stop(void);
+volatile uint8_t DMA1_CH1_get_transfer_status(void);
+
+void DMA1_CH3_init(void);
+void DMA1_CH3_set_destination_address(uint32_t destination_buffer_address, uint16_t destination_buffer_size);
+void DMA1_CH3_start(void);
+void DMA1_CH3_stop(void);
+uint16_t DMA1_CH3_get_number_of_remaining_transfers(void);
+
+void DMA1_CH5_init(void);
+void DMA1_CH5_set_destination_address(uint32_t destination_buffer_address, uint16_t destination_buffer_size);
+void DMA1_CH5_start(void);
+void DMA1_CH5_stop(void);
+uint16_t DMA1_CH5_get_number_of_remaining_transfers(void);
+
+#endif /* __DMA_H__ */
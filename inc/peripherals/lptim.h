@@ -24,6 +24,10 @@ typedef enum {
 
 void LPTIM1_init(uint32_t lsi_freq_hz);
 LPTIM_status_t LPTIM1_delay_milliseconds(uint32_t delay_ms, uint8_t stop_mode);
+LPTIM_status_t LPTIM1_start_timer(uint32_t timeout_ms);
+void LPTIM1_stop_timer(void);
+uint8_t LPTIM1_get_timer_flag(void);
+uint32_t LPTIM1_get_timer_elapsed_ms(void);
 
 #define LPTIM1_status_check(error_base) { if (lptim1_status != LPTIM_SUCCESS) { status = error_base + lptim1_status; goto errors; }}
 #define LPTIM1_error_check() { ERROR_status_check(lptim1_status, LPTIM_SUCCESS, ERROR_BASE_LPTIM1); }
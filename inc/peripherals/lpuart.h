@@ -21,6 +21,8 @@ typedef enum {
 	LPUART_ERROR_TX_TIMEOUT,
 	LPUART_ERROR_TC_TIMEOUT,
 	LPUART_ERROR_STRING_SIZE,
+	LPUART_ERROR_TX_BUFFER_FULL,
+	LPUART_ERROR_BAUD_RATE,
 	LPUART_ERROR_BASE_LAST = 0x0100
 } LPUART_status_t;
 
@@ -28,9 +30,18 @@ typedef enum {
 
 LPUART_status_t LPUART1_init(RS485_address_t node_address);
 LPUART_status_t LPUART1_set_mode(RS485_mode_t mode);
+LPUART_status_t LPUART1_set_baud_rate(uint32_t baud_rate);
 void LPUART1_enable_rx(void);
 void LPUART1_disable_rx(void);
 LPUART_status_t LPUART1_send_command(RS485_address_t slave_address, char_t* command);
+void LPUART1_process_rx_dma(void);
+void LPUART1_enable_wake_up(void);
+void LPUART1_disable_wake_up(void);
+uint8_t LPUART1_is_idle(void);
+uint8_t LPUART1_is_tx_running(void);
+uint32_t LPUART1_get_baud_rate(void);
+uint32_t LPUART1_get_rx_overruns(void);
+void LPUART1_reset_rx_overruns(void);
 
 #define LPUART1_status_check(error_base) { if (lpuart1_status != LPUART_SUCCESS) { status = error_base + lpuart1_status; goto errors; }}
 #define LPUART1_error_check() { ERROR_status_check(lpuart1_status, LPUART_SUCCESS, ERROR_BASE_LPUART1); }
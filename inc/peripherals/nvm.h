@@ -24,7 +24,11 @@ typedef enum {
 
 typedef enum {
 	NVM_ADDRESS_RS485_ADDRESS = 0,
-	NVM_ADDRESS_LAST
+	NVM_ADDRESS_NODE_COUNT,
+	NVM_ADDRESS_NODE_TABLE,
+	NVM_ADDRESS_RS485_BAUD_RATE = (NVM_ADDRESS_NODE_TABLE + 64), // 16 nodes of 4 bytes.
+	NVM_ADDRESS_HOST_BAUD_RATE = (NVM_ADDRESS_RS485_BAUD_RATE + 4), // 32-bits value, LSB first.
+	NVM_ADDRESS_LAST = (NVM_ADDRESS_HOST_BAUD_RATE + 4) // 32-bits value, LSB first.
 } NVM_address_t;
 
 /*** NVM functions ***/
@@ -32,6 +36,8 @@ typedef enum {
 void NVM_init(void);
 NVM_status_t NVM_read_byte(NVM_address_t address_offset, uint8_t* data);
 NVM_status_t NVM_write_byte(NVM_address_t address_offset, uint8_t data);
+NVM_status_t NVM_read_word(NVM_address_t address_offset, uint32_t* data);
+NVM_status_t NVM_write_word(NVM_address_t address_offset, uint32_t data);
 
 #define NVM_status_check(error_base) { if (nvm_status != NVM_SUCCESS) { status = error_base + nvm_status; goto errors; }}
 #define NVM_error_check() { ERROR_status_check(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM); }
@@ -8,11 +8,27 @@
 #ifndef __PWR_H__
 #define __PWR_H__
 
+#include "mode.h"
+#include "types.h"
+
+/*** PWR structures ***/
+
+typedef enum {
+	PWR_STATE_RUN = 0,
+	PWR_STATE_SLEEP,
+	PWR_STATE_STOP,
+	PWR_STATE_LAST
+} PWR_state_t;
+
 /*** PWR functions ***/
 
 void PWR_init(void);
 void PWR_enter_sleep_mode(void);
 void PWR_enter_stop_mode(void);
 void PWR_software_reset(void);
+#ifdef PWR_STATISTICS
+void PWR_reset_statistics(void);
+uint32_t PWR_get_state_time_ms(PWR_state_t state);
+#endif
 
 #endif /* __PWR_H__ */
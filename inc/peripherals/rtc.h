@@ -34,9 +34,12 @@ RTC_status_t __attribute__((optimize("-O0"))) RTC_init(uint8_t* rtc_use_lse, uin
 
 RTC_status_t RTC_start_wakeup_timer(uint32_t delay_seconds);
 RTC_status_t RTC_stop_wakeup_timer(void);
-volatile uint8_t RTC_get_wakeup_timer_flag(void);
 void RTC_clear_wakeup_timer_flag(void);
 
+uint32_t RTC_get_time_ms(void);
+uint32_t RTC_get_time_seconds(void);
+uint32_t RTC_get_duration_ms(uint32_t start_time_ms, uint32_t end_time_ms);
+
 #define RTC_status_check(error_base) { if (rtc_status != RTC_SUCCESS) { status = error_base + rtc_status; goto errors; }}
 #define RTC_error_check() { ERROR_status_check(rtc_status, RTC_SUCCESS, ERROR_BASE_RTC); }
 #define RTC_error_check_print() { ERROR_status_check(rtc_status, RTC_SUCCESS, ERROR_BASE_RTC); }
@@ -17,15 +17,39 @@ typedef enum {
 	USART_ERROR_NULL_PARAMETER,
 	USART_ERROR_TX_TIMEOUT,
 	USART_ERROR_STRING_SIZE,
+	USART_ERROR_TX_BUFFER_FULL,
+	USART_ERROR_BAUD_RATE,
 	USART_ERROR_BASE_LAST = 0x0100
 } USART_status_t;
 
+typedef enum {
+	USART_BAUD_RATE_STATUS_CONFIRMED = 0,
+	USART_BAUD_RATE_STATUS_PENDING,
+	USART_BAUD_RATE_STATUS_UNCONFIRMED,
+	USART_BAUD_RATE_STATUS_LAST
+} USART_baud_rate_status_t;
+
 /*** USART functions ***/
 
 void USART2_init(void);
 void USART2_enable_interrupt(void);
 void USART2_disable_interrupt(void);
+void USART2_enable_wake_up(void);
+void USART2_disable_wake_up(void);
+uint8_t USART2_is_idle(void);
+void USART2_process_rx_dma(void);
+USART_status_t USART2_send_bytes(uint8_t* tx_data, uint32_t tx_data_size);
 USART_status_t USART2_send_string(char_t* tx_string);
+void USART2_flush(void);
+uint32_t USART2_get_tx_high_water_mark(void);
+uint32_t USART2_get_tx_dropped_bytes(void);
+uint32_t USART2_get_rx_overruns(void);
+void USART2_reset_statistics(void);
+USART_status_t USART2_set_baud_rate(uint32_t baud_rate);
+uint32_t USART2_get_baud_rate(void);
+USART_baud_rate_status_t USART2_get_baud_rate_status(void);
+void USART2_confirm_baud_rate(void);
+void USART2_revert_baud_rate(void);
 
 #define USART_status_check(error_base) { if (usart_status != USART_SUCCESS) { status = error_base + usart_status; goto errors; }}
 #define USART_error_check() { ERROR_status_check(usart_status, USART_SUCCESS, ERROR_BASE_USART); }
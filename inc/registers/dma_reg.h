@@ -0,0 +1,35 @@
+/*
+ * dma_reg.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __DMA_REG_H__
+#define __DMA_REG_H__
+
+#include "types.h"
+
+/*** DMA registers ***/
+
+typedef struct {
+	volatile uint32_t CCR;			// DMA channel x configuration register.
+	volatile uint32_t CNDTR;		// DMA channel x number of data register.
+	volatile uint32_t CPAR;			// DMA channel x peripheral address register.
+	volatile uint32_t CMAR;			// DMA channel x memory address register.
+	volatile uint32_t RESERVED;		// Reserved.
+} DMA_channel_t;
+
+typedef struct {
+	volatile uint32_t ISR;			// DMA interrupt status register.
+	volatile uint32_t IFCR;			// DMA interrupt flag clear register.
+	DMA_channel_t CH[7];			// DMA channels 1 to 7 (index 0 to 6).
+	volatile uint32_t RESERVED[5];	// Reserved 0x94.
+	volatile uint32_t CSELR;		// DMA channel selection register.
+} DMA_base_address_t;
+
+/*** DMA base address ***/
+
+#define DMA1	((DMA_base_address_t*) ((uint32_t) 0x40020000))
+
+#endif /* __DMA_REG_H__ */
@@ -0,0 +1,26 @@
+/*
+ * systick_reg.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SYSTICK_REG_H__
+#define __SYSTICK_REG_H__
+
+#include "types.h"
+
+/*** SYSTICK registers ***/
+
+typedef struct {
+	volatile uint32_t CSR;		// SysTick control and status register.
+	volatile uint32_t RVR;		// SysTick reload value register.
+	volatile uint32_t CVR;		// SysTick current value register.
+	volatile uint32_t CALIB;	// SysTick calibration value register.
+} SYSTICK_base_address_t;
+
+/*** SYSTICK base address ***/
+
+#define SYSTICK		((SYSTICK_base_address_t*) ((uint32_t) 0xE000E010))
+
+#endif /* __SYSTICK_REG_H__ */
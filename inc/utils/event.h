@@ -0,0 +1,29 @@
+/*
+ * event.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __EVENT_H__
+#define __EVENT_H__
+
+#include "types.h"
+
+/*** EVENT structures ***/
+
+typedef enum {
+	EVENT_HOST_RX = 0,
+	EVENT_RS485_RX,
+	EVENT_RTC_WAKEUP,
+	EVENT_NODE_SCAN,
+	EVENT_LAST
+} EVENT_t;
+
+/*** EVENT functions ***/
+
+void EVENT_post(EVENT_t event);
+uint8_t EVENT_take(EVENT_t event);
+uint8_t EVENT_is_pending(void);
+
+#endif /* __EVENT_H__ */
@@ -0,0 +1,55 @@
+/*
+ * prof.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __PROF_H__
+#define __PROF_H__
+
+#include "mode.h"
+#include "types.h"
+
+/*** PROF macros ***/
+
+#define PROF_COUNT_MAX	0x7FFFFFFF // Statistics used for the average are frozen once this count is reached.
+
+/*** PROF structures ***/
+
+typedef enum {
+	PROF_PROBE_LPUART1_IRQ = 0,
+	PROF_PROBE_USART2_IRQ,
+	PROF_PROBE_AT_DECODE,
+	PROF_PROBE_STRING_VALUE_TO_STRING,
+	PROF_PROBE_ADC1_COMPUTE,
+	PROF_PROBE_LAST
+} PROF_probe_t;
+
+typedef struct {
+	uint32_t count;
+	uint32_t min_cycles;
+	uint32_t max_cycles;
+	uint64_t total_cycles; // Can not overflow before the count saturates (2^31 measurements of 2^24 cycles maximum).
+} PROF_statistics_t;
+
+/*** PROF functions ***/
+
+#ifdef PROFILING
+void PROF_init(void);
+void PROF_start_probe(PROF_probe_t probe);
+void PROF_stop_probe(PROF_probe_t probe);
+void PROF_get_statistics(PROF_probe_t probe, PROF_statistics_t* statistics);
+void PROF_reset_statistics(void);
+#endif
+
+// Probes are removed from the code when profiling is disabled.
+#ifdef PROFILING
+#define PROF_enter(probe) { PROF_start_probe(probe); }
+#define PROF_exit(probe) { PROF_stop_probe(probe); }
+#else
+#define PROF_enter(probe)
+#define PROF_exit(probe)
+#endif
+
+#endif /* __PROF_H__ */
@@ -20,6 +20,8 @@
 #define STRING_CHAR_MINUS	'-'
 #define STRING_CHAR_DOT		'.'
 
+#define STRING_VALUE_BUFFER_SIZE	36 // Worst case of a value conversion: minus sign, prefix, 32 binary digits and null character.
+
 /*** STRING structures ***/
 
 typedef enum {
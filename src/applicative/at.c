@@ -8,19 +8,25 @@
 #include "at.h"
 
 #include "adc.h"
+#include "bin.h"
 #include "config.h"
 #include "dim.h"
 #include "dinfox.h"
 #include "error.h"
+#include "event.h"
+#include "iwdg.h"
 #include "lptim.h"
 #include "mapping.h"
 #include "math.h"
+#include "node.h"
 #include "nvic.h"
+#include "nvm.h"
 #include "parser.h"
+#include "prof.h"
 #include "pwr.h"
-#include "rcc_reg.h"
 #include "rs485.h"
 #include "rs485_common.h"
+#include "rtc.h"
 #include "string.h"
 #include "types.h"
 #include "usart.h"
@@ -30,16 +36,27 @@
 
 // Commands.
 #define AT_COMMAND_BUFFER_SIZE			128
+#define AT_COMMAND_RING_SIZE			256 // Must be a power of 2.
 // Parameters separator.
 #define AT_CHAR_SEPARATOR				','
+#define AT_CHAR_HEADER_END				'='
+#define AT_CHAR_RANGE					'-'
+// Dispatch hash table.
+#define AT_HASH_TABLE_SIZE				32 // Must be a power of 2 greater than the number of commands.
+#define AT_HASH_TABLE_EMPTY				0xFF
+// Registers list.
+#define AT_REGISTER_LIST_SIZE			32
 // Replies.
 #define AT_REPLY_BUFFER_SIZE			128
 #define AT_REPLY_END					"\r\n"
 #define AT_REPLY_TAB					"     "
-#define AT_STRING_VALUE_BUFFER_SIZE		16
 // RS485 variables.
 #define AT_RS485_COMMAND_HEADER			"*"
-#define AT_RS485_NODES_LIST_SIZE		16
+// Benchmark.
+#define AT_BENCH_COUNT_MAX				100
+#define AT_BENCH_COMMAND				"RS$R=01"
+// Host baud rate switch.
+#define AT_BAUD_RATE_CONFIRMATION_TIMEOUT_MS	15000
 
 /*** AT callbacks declaration ***/
 
@@ -49,9 +66,23 @@ static void _AT_print_sw_version(void);
 static void _AT_print_error_stack(void);
 static void _AT_adc_callback(void);
 static void _AT_scan_callback(void);
+static void _AT_scan_range_callback(void);
+static void _AT_rescan_callback(void);
+static void _AT_nodes_callback(void);
 static void _AT_read_callback(void);
 static void _AT_write_callback(void);
 static void _AT_send_rs485_command_callback(void);
+static void _AT_bench_callback(void);
+static void _AT_transaction_callback(void);
+static void _AT_binary_mode_callback(void);
+#ifdef PWR_STATISTICS
+static void _AT_pwr_callback(void);
+static void _AT_pwr_reset_callback(void);
+#endif
+#ifdef PROFILING
+static void _AT_prof_callback(void);
+static void _AT_prof_reset_callback(void);
+#endif
 
 /*** AT local structures ***/
 
@@ -63,18 +94,37 @@ typedef struct {
 	void (*callback)(void);
 } AT_command_t;
 
+typedef enum {
+	AT_BAUD_RATE_STATE_IDLE = 0,
+	AT_BAUD_RATE_STATE_REQUESTED, // New baud rate written, switch is performed once the reply has been sent.
+	AT_BAUD_RATE_STATE_SWITCHED, // Lines received before the switch are still in the ring.
+	AT_BAUD_RATE_STATE_AWAITING_CONFIRMATION, // Next valid line has been received with the new baud rate.
+	AT_BAUD_RATE_STATE_LAST
+} AT_baud_rate_state_t;
+
 typedef struct {
-	// Command.
-	volatile char_t command[AT_COMMAND_BUFFER_SIZE];
-	volatile uint32_t command_size;
-	volatile uint8_t line_end_flag;
+	// Reception ring: command lines are stored as a length byte followed by characters (written by USART interrupt only).
+	volatile uint8_t rx_ring[AT_COMMAND_RING_SIZE];
+	volatile uint32_t rx_write_idx; // Committed lines end (producer).
+	volatile uint32_t rx_read_idx; // Next line to execute (consumer).
+	volatile uint32_t rx_line_start_idx; // Length byte index of the line being received.
+	volatile uint8_t rx_line_size;
+	volatile uint8_t rx_line_overflow;
+	// Current command (linear copy of the line read from ring).
+	char_t command[AT_COMMAND_BUFFER_SIZE];
+	uint32_t command_size;
 	PARSER_context_t parser;
 	// Replies.
 	char_t reply[AT_REPLY_BUFFER_SIZE];
 	uint32_t reply_size;
 	// RS485.
 	uint8_t node_address;
-	RS485_mode_t rs485_mode;
+	// Host baud rate switch.
+	AT_baud_rate_state_t baud_rate_state;
+	uint32_t baud_rate_switch_time_ms;
+	uint32_t baud_rate_switch_ring_idx; // Reception ring write index when the switch was applied.
+	// Resumable scan.
+	uint32_t scan_start_ms;
 } AT_context_t;
 
 /*** AT local global variables ***/
@@ -86,14 +136,32 @@ static const AT_command_t AT_COMMAND_LIST[] = {
 	{PARSER_MODE_COMMAND, "AT$ERROR?", STRING_NULL, "Read error stack", _AT_print_error_stack},
 	{PARSER_MODE_COMMAND, "AT$RST", STRING_NULL, "Reset MCU", PWR_software_reset},
 	{PARSER_MODE_COMMAND, "AT$ADC?", STRING_NULL, "Get ADC measurements", _AT_adc_callback},
+#ifdef PWR_STATISTICS
+	{PARSER_MODE_COMMAND, "AT$PWR?", STRING_NULL, "Get time spent in each power state", _AT_pwr_callback},
+	{PARSER_MODE_COMMAND, "AT$PWRRST", STRING_NULL, "Reset power states measurement", _AT_pwr_reset_callback},
+#endif
+#ifdef PROFILING
+	{PARSER_MODE_COMMAND, "AT$PROF?", STRING_NULL, "Get hot paths duration in core clock cycles", _AT_prof_callback},
+	{PARSER_MODE_COMMAND, "AT$PROFRST", STRING_NULL, "Reset hot paths profiling", _AT_prof_reset_callback},
+#endif
 	{PARSER_MODE_COMMAND, "AT$SCAN", STRING_NULL, "Scan all slaves connected to the RS485 bus", _AT_scan_callback},
-	{PARSER_MODE_HEADER, "AT$R=", "address[hex]", "Read register", _AT_read_callback},
+	{PARSER_MODE_HEADER, "AT$SCAN=", "first_address[hex],last_address[hex]", "Scan a range of RS485 addresses", _AT_scan_range_callback},
+	{PARSER_MODE_COMMAND, "AT$RESCAN", STRING_NULL, "Probe known nodes and next unknown addresses", _AT_rescan_callback},
+	{PARSER_MODE_COMMAND, "AT$NODES?", STRING_NULL, "Print known nodes", _AT_nodes_callback},
+	{PARSER_MODE_HEADER, "AT$TX=", "node_address[hex],command[str]", "Send a command to a RS485 node and wait for its reply", _AT_transaction_callback},
+	{PARSER_MODE_HEADER, "AT$BENCH=", "node_address[hex],count[dec]", "Measure RS485 transactions rate and latency", _AT_bench_callback},
+	{PARSER_MODE_HEADER, "AT$R=", "address[hex] or list[hex,hex-hex,...]", "Read register(s)", _AT_read_callback},
 	{PARSER_MODE_HEADER, "AT$W=", "address[hex],value[hex]", "Write register",_AT_write_callback},
+	{PARSER_MODE_COMMAND, "AT$BIN", STRING_NULL, "Switch host interface to binary protocol", _AT_binary_mode_callback},
 	{PARSER_MODE_HEADER, AT_RS485_COMMAND_HEADER, "node_address[hex],command[str]", "Send a command to a specific RS485 node", _AT_send_rs485_command_callback},
 	{PARSER_MODE_HEADER, AT_RS485_COMMAND_HEADER, "command[str]", "Send a command over RS485 bus without any address header", _AT_send_rs485_command_callback},
 };
 
 static AT_context_t at_ctx;
+static uint8_t at_hash_table[AT_HASH_TABLE_SIZE];
+
+// At least one slot must remain empty to end the linear probing loops.
+_Static_assert((sizeof(AT_COMMAND_LIST) / sizeof(AT_command_t)) < AT_HASH_TABLE_SIZE, "AT_HASH_TABLE_SIZE must be greater than the number of commands");
 
 /*** AT local functions ***/
 
@@ -126,15 +194,20 @@ static void _AT_reply_add_string(char_t* tx_string) {
 static void _AT_reply_add_value(int32_t tx_value, STRING_format_t format, uint8_t print_prefix) {
 	// Local variables.
 	STRING_status_t string_status = STRING_SUCCESS;
-	char_t str_value[AT_STRING_VALUE_BUFFER_SIZE];
-	uint8_t idx = 0;
-	// Reset string.
-	for (idx=0 ; idx<AT_STRING_VALUE_BUFFER_SIZE ; idx++) str_value[idx] = STRING_CHAR_NULL;
-	// Convert value to string.
-	string_status = STRING_value_to_string(tx_value, format, print_prefix, str_value);
+	// Check remaining space.
+	if ((at_ctx.reply_size + STRING_VALUE_BUFFER_SIZE) > AT_REPLY_BUFFER_SIZE) {
+		ERROR_stack_add(ERROR_REPLY_OVERFLOW);
+		goto errors;
+	}
+	// Convert value directly in the reply buffer.
+	string_status = STRING_value_to_string(tx_value, format, print_prefix, &(at_ctx.reply[at_ctx.reply_size]));
 	STRING_error_check();
-	// Add string.
-	_AT_reply_add_string(str_value);
+	// Update size (null character is excluded).
+	while (at_ctx.reply[at_ctx.reply_size] != STRING_CHAR_NULL) {
+		at_ctx.reply_size++;
+	}
+errors:
+	return;
 }
 
 /* SEND AT REPONSE OVER AT INTERFACE.
@@ -191,6 +264,8 @@ static void _AT_print_command_list(void) {
 	uint32_t idx = 0;
 	// Commands loop.
 	for (idx=0 ; idx<(sizeof(AT_COMMAND_LIST) / sizeof(AT_command_t)) ; idx++) {
+		// Wait for TX FIFO since the whole list does not fit in it.
+		USART2_flush();
 		// Print syntax.
 		_AT_reply_add_string(AT_COMMAND_LIST[idx].syntax);
 		// Print parameters.
@@ -301,57 +376,242 @@ errors:
 	return;
 }
 
-/* AT$SCAN EXECUTION CALLBACK.
+#ifdef PWR_STATISTICS
+/* AT$PWR? EXECUTION CALLBACK.
  * @param:	None.
  * @return:	None.
  */
-static void _AT_scan_callback(void) {
+static void _AT_pwr_callback(void) {
 	// Local variables.
-	RS485_status_t rs485_status = RS485_SUCCESS;
-	RS485_node_t node_list[AT_RS485_NODES_LIST_SIZE];
-	uint8_t number_of_nodes_found = 0;
+	char_t* state_name[PWR_STATE_LAST] = {"Run=", "Sleep=", "Stop="};
 	uint8_t idx = 0;
-	// Check if TX is allowed.
-	if (CONFIG_get_tx_mode() == CONFIG_TX_DISABLED) {
-		_AT_print_error(ERROR_TX_DISABLED);
-		goto errors;
+	// Print time spent in each state.
+	for (idx=0 ; idx<PWR_STATE_LAST ; idx++) {
+		_AT_reply_add_string(state_name[idx]);
+		_AT_reply_add_value((int32_t) PWR_get_state_time_ms(idx), STRING_FORMAT_DECIMAL, 0);
+		_AT_reply_add_string("ms");
+		_AT_reply_send();
 	}
-	// Perform bus scan.
-	_AT_reply_add_string("RS485 bus scan running...");
-	_AT_reply_send();
-	rs485_status = RS485_set_mode(RS485_MODE_ADDRESSED);
-	RS485_error_check_print();
-	rs485_status = RS485_scan_nodes(node_list, AT_RS485_NODES_LIST_SIZE, &number_of_nodes_found);
-	RS485_error_check_print();
-	// Print result.
-	_AT_reply_add_value((int32_t) number_of_nodes_found, STRING_FORMAT_DECIMAL, 0);
-	_AT_reply_add_string(" node(s) found");
+	_AT_print_ok();
+}
+
+/* AT$PWRRST EXECUTION CALLBACK.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _AT_pwr_reset_callback(void) {
+	PWR_reset_statistics();
+	_AT_print_ok();
+}
+#endif
+
+#ifdef PROFILING
+/* AT$PROF? EXECUTION CALLBACK.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _AT_prof_callback(void) {
+	// Local variables.
+	char_t* probe_name[PROF_PROBE_LAST] = {"LPUART1_IRQ", "USART2_IRQ", "AT_decode", "STRING_value_to_string", "ADC1_compute"};
+	PROF_statistics_t statistics;
+	uint8_t idx = 0;
+	// Print statistics of each probe.
+	for (idx=0 ; idx<PROF_PROBE_LAST ; idx++) {
+		PROF_get_statistics(idx, &statistics);
+		_AT_reply_add_string(probe_name[idx]);
+		_AT_reply_add_string(": count=");
+		_AT_reply_add_value((int32_t) statistics.count, STRING_FORMAT_DECIMAL, 0);
+		if (statistics.count >= PROF_COUNT_MAX) {
+			_AT_reply_add_string(" (saturated)");
+		}
+		if (statistics.count != 0) {
+			_AT_reply_add_string(" min=");
+			_AT_reply_add_value((int32_t) statistics.min_cycles, STRING_FORMAT_DECIMAL, 0);
+			_AT_reply_add_string(" max=");
+			_AT_reply_add_value((int32_t) statistics.max_cycles, STRING_FORMAT_DECIMAL, 0);
+			_AT_reply_add_string(" avg=");
+			_AT_reply_add_value((int32_t) (statistics.total_cycles / statistics.count), STRING_FORMAT_DECIMAL, 0);
+			_AT_reply_add_string(" cycles");
+		}
+		_AT_reply_send();
+	}
+	_AT_print_ok();
+}
+
+/* AT$PROFRST EXECUTION CALLBACK.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _AT_prof_reset_callback(void) {
+	PROF_reset_statistics();
+	_AT_print_ok();
+}
+#endif
+
+/* PRINT NODES TABLE.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _AT_print_nodes(void) {
+	// Local variables.
+	NODE_status_t node_status = NODE_SUCCESS;
+	NODE_t node;
+	uint8_t number_of_nodes = NODE_get_count();
+	uint8_t idx = 0;
+	uint32_t last_seen_age_ms = 0;
+	// Print count.
+	_AT_reply_add_value((int32_t) number_of_nodes, STRING_FORMAT_DECIMAL, 0);
+	_AT_reply_add_string(" node(s) known");
 	_AT_reply_send();
-	for (idx=0 ; idx<number_of_nodes_found ; idx++) {
+	for (idx=0 ; idx<number_of_nodes ; idx++) {
+		// Wait for TX FIFO since the whole table does not fit in it.
+		USART2_flush();
+		// Read node.
+		node_status = NODE_get(idx, &node);
+		NODE_error_check_print();
 		// Print address.
-		_AT_reply_add_value(node_list[idx].address, STRING_FORMAT_HEXADECIMAL, 1);
+		_AT_reply_add_value(node.node.address, STRING_FORMAT_HEXADECIMAL, 1);
 		_AT_reply_add_string(" : ");
 		// Print board type.
-		if (node_list[idx].board_id == DINFOX_BOARD_ID_ERROR) {
+		if (node.node.board_id == DINFOX_BOARD_ID_ERROR) {
 			_AT_reply_add_string("Board ID error");
 		}
 		else {
-			if (node_list[idx].board_id >= DINFOX_BOARD_ID_LAST) {
+			if (node.node.board_id >= DINFOX_BOARD_ID_LAST) {
 				_AT_reply_add_string("Unknown board ID (");
-				_AT_reply_add_value((int32_t) (node_list[idx].board_id), STRING_FORMAT_HEXADECIMAL, 1);
+				_AT_reply_add_value((int32_t) (node.node.board_id), STRING_FORMAT_HEXADECIMAL, 1);
 				_AT_reply_add_string(")");
 			}
 			else {
-				_AT_reply_add_string((char_t*) DINFOX_BOARD_ID_NAME[node_list[idx].board_id]);
+				_AT_reply_add_string((char_t*) DINFOX_BOARD_ID_NAME[node.node.board_id]);
 			}
 		}
+		// Print reply time.
+		_AT_reply_add_string(" (");
+		_AT_reply_add_value((int32_t) node.node.reply_time_ms, STRING_FORMAT_DECIMAL, 0);
+		_AT_reply_add_string("ms) ");
+		// Print last seen time.
+		if (node.seen_flag == 0) {
+			_AT_reply_add_string("not seen since boot");
+		}
+		else {
+			last_seen_age_ms = RTC_get_duration_ms(node.last_seen_ms, RTC_get_time_ms());
+			_AT_reply_add_string("seen ");
+			_AT_reply_add_value((int32_t) (last_seen_age_ms / 1000), STRING_FORMAT_DECIMAL, 0);
+			_AT_reply_add_string("s ago");
+		}
 		_AT_reply_send();
 	}
+errors:
+	return;
+}
+
+/* PRINT SCAN DURATION AND RESULT.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _AT_print_scan_result(void) {
+	// Print duration.
+	_AT_reply_add_string("Scan duration ");
+	_AT_reply_add_value((int32_t) RTC_get_duration_ms(at_ctx.scan_start_ms, RTC_get_time_ms()), STRING_FORMAT_DECIMAL, 0);
+	_AT_reply_add_string("ms");
+	_AT_reply_send();
+	// Print result.
+	_AT_print_nodes();
 	_AT_print_ok();
+}
+
+/* SCAN RS485 BUS AND PRINT RESULT.
+ * @param first_address:	First address to probe.
+ * @param last_address:		Last address to probe (included).
+ * @param full_scan:		Scan the given range if non zero, perform an incremental rescan otherwise.
+ * @return:					None.
+ * Note: the full scan is resumable (see AT_scan_task() function), so that other commands and bus frames are processed in the meantime.
+ */
+static void _AT_scan(RS485_address_t first_address, RS485_address_t last_address, uint8_t full_scan) {
+	// Local variables.
+	NODE_status_t node_status = NODE_SUCCESS;
+	// Check if TX is allowed.
+	if (CONFIG_get_tx_mode() == CONFIG_TX_DISABLED) {
+		_AT_print_error(ERROR_TX_DISABLED);
+		goto errors;
+	}
+	if (NODE_is_scan_running() != 0) {
+		_AT_print_error(ERROR_BUSY_SCAN_RUNNING);
+		goto errors;
+	}
+	// Perform bus scan.
+	_AT_reply_add_string("RS485 bus scan running...");
+	_AT_reply_send();
+	at_ctx.scan_start_ms = RTC_get_time_ms();
+	if (full_scan == 0) {
+		// Incremental rescan is short enough to be blocking.
+		node_status = NODE_rescan();
+		NODE_error_check_print();
+		_AT_print_scan_result();
+	}
+	else {
+		// Start resumable scan.
+		node_status = NODE_start_scan(first_address, last_address);
+		NODE_error_check_print();
+		EVENT_post(EVENT_NODE_SCAN);
+	}
+errors:
+	return;
+}
+
+/* AT$SCAN EXECUTION CALLBACK.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _AT_scan_callback(void) {
+	// Scan all addresses.
+	_AT_scan(0, RS485_ADDRESS_LAST, 1);
+}
+
+/* AT$SCAN= EXECUTION CALLBACK.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _AT_scan_range_callback(void) {
+	// Local variables.
+	PARSER_status_t parser_status = PARSER_SUCCESS;
+	int32_t first_address = 0;
+	int32_t last_address = 0;
+	// Read range.
+	parser_status = PARSER_get_parameter(&at_ctx.parser, STRING_FORMAT_HEXADECIMAL, AT_CHAR_SEPARATOR, &first_address);
+	PARSER_error_check_print();
+	parser_status = PARSER_get_parameter(&at_ctx.parser, STRING_FORMAT_HEXADECIMAL, STRING_CHAR_NULL, &last_address);
+	PARSER_error_check_print();
+	// Check range.
+	if ((first_address < 0) || (first_address > last_address) || (last_address > RS485_ADDRESS_LAST)) {
+		_AT_print_error(ERROR_RS485_ADDRESS);
+		goto errors;
+	}
+	_AT_scan((RS485_address_t) first_address, (RS485_address_t) last_address, 1);
 errors:
 	return;
 }
 
+/* AT$RESCAN EXECUTION CALLBACK.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _AT_rescan_callback(void) {
+	// Probe known nodes and next unknown addresses.
+	_AT_scan(0, RS485_ADDRESS_LAST, 0);
+}
+
+/* AT$NODES? EXECUTION CALLBACK.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _AT_nodes_callback(void) {
+	// Print cached table.
+	_AT_print_nodes();
+	_AT_print_ok();
+}
+
 /* RS485 COMMAND EXECUTION CALLBACK.
  * @param:	None.
  * @return:	None.
@@ -360,6 +620,7 @@ static void _AT_send_rs485_command_callback(void) {
 	// Local variables.
 	PARSER_status_t parser_status = PARSER_SUCCESS;
 	RS485_status_t rs485_status = RS485_SUCCESS;
+	RS485_mode_t rs485_mode = RS485_MODE_ADDRESSED;
 	int32_t slave_address = 0;
 	uint8_t command_offset = 0;
 	// Check if TX is allowed.
@@ -367,27 +628,31 @@ static void _AT_send_rs485_command_callback(void) {
 		_AT_print_error(ERROR_TX_DISABLED);
 		goto errors;
 	}
+	if (NODE_is_scan_running() != 0) {
+		_AT_print_error(ERROR_BUSY_SCAN_RUNNING);
+		goto errors;
+	}
 	// Try parsing node address.
 	parser_status = PARSER_get_parameter(&at_ctx.parser, STRING_FORMAT_HEXADECIMAL, AT_CHAR_SEPARATOR, &slave_address);
 	// Check status to determine mode.
 	if (parser_status == PARSER_SUCCESS) {
 		// Addressed mode.
-		at_ctx.rs485_mode = RS485_MODE_ADDRESSED;
+		rs485_mode = RS485_MODE_ADDRESSED;
 		_AT_reply_add_string("Addressed mode");
 		command_offset = at_ctx.parser.separator_idx + 1;
 	}
 	else {
 		// Direct mode.
-		at_ctx.rs485_mode = RS485_MODE_DIRECT;
+		rs485_mode = RS485_MODE_DIRECT;
 		_AT_reply_add_string("Direct mode");
 		command_offset = 1;
 	}
 	_AT_reply_send();
 	// Set mode.
-	rs485_status = RS485_set_mode(at_ctx.rs485_mode);
+	rs485_status = RS485_set_mode(rs485_mode);
 	RS485_error_check_print();
 	// Print command in addressed mode.
-	if (at_ctx.rs485_mode == RS485_MODE_ADDRESSED) {
+	if (rs485_mode == RS485_MODE_ADDRESSED) {
 		_AT_reply_add_value(at_ctx.node_address, STRING_FORMAT_HEXADECIMAL, 1);
 		_AT_reply_add_string(" > ");
 		_AT_reply_add_value(slave_address, STRING_FORMAT_HEXADECIMAL, 1);
@@ -402,95 +667,293 @@ errors:
 	return;
 }
 
-/* AT$R EXECUTION CALLBACK.
+/* AT$TX EXECUTION CALLBACK.
  * @param:	None.
  * @return:	None.
+ * Note: the reply, its status and the turnaround time (measured from the end of the command transmission) are printed in a single response.
  */
-static void _AT_read_callback(void) {
+static void _AT_transaction_callback(void) {
 	// Local variables.
 	PARSER_status_t parser_status = PARSER_SUCCESS;
-	NVM_status_t nvm_status = NVM_SUCCESS;
-	ADC_status_t adc1_status = ADC_SUCCESS;
-	int32_t register_address = 0;
-	uint8_t generic_u8 = 0;
-	int8_t generic_s8 = 0;
-	uint32_t generic_u32 = 0;
-	// Read address parameter.
-	parser_status = PARSER_get_parameter(&at_ctx.parser, STRING_FORMAT_HEXADECIMAL, STRING_CHAR_NULL, &register_address);
+	RS485_status_t rs485_status = RS485_SUCCESS;
+	RS485_transaction_t transaction;
+	char_t* reply_status_name[RS485_REPLY_STATUS_LAST] = {"OK", "ERROR", "VALUE", "RAW"};
+	int32_t slave_address = 0;
+	// Read node address.
+	parser_status = PARSER_get_parameter(&at_ctx.parser, STRING_FORMAT_HEXADECIMAL, AT_CHAR_SEPARATOR, &slave_address);
 	PARSER_error_check_print();
-	// Get data.
-	switch (register_address) {
-	case DINFOX_REGISTER_RS485_ADDRESS:
-		nvm_status = NVM_read_byte(NVM_ADDRESS_RS485_ADDRESS, &generic_u8);
-		NVM_error_check_print();
-		_AT_reply_add_value(generic_u8, STRING_FORMAT_HEXADECIMAL, 0);
-		break;
-	case DINFOX_REGISTER_BOARD_ID:
-		_AT_reply_add_value(DINFOX_BOARD_ID_DIM, STRING_FORMAT_HEXADECIMAL, 0);
-		break;
-	case DINFOX_REGISTER_HW_VERSION_MAJOR:
-#if (defined HW1_0) || (defined HW1_1)
-		_AT_reply_add_value(1, STRING_FORMAT_DECIMAL, 0);
-#endif
-		break;
-	case DINFOX_REGISTER_HW_VERSION_MINOR:
-#ifdef HW1_0
-		_AT_reply_add_value(0, STRING_FORMAT_DECIMAL, 0);
-#endif
-#ifdef HW1_1
-		_AT_reply_add_value(1, STRING_FORMAT_DECIMAL, 0);
+	if ((slave_address < 0) || (slave_address > RS485_ADDRESS_LAST)) {
+		_AT_print_error(ERROR_RS485_ADDRESS);
+		goto errors;
+	}
+	// Check if TX is allowed.
+	if (CONFIG_get_tx_mode() == CONFIG_TX_DISABLED) {
+		_AT_print_error(ERROR_TX_DISABLED);
+		goto errors;
+	}
+	if (NODE_is_scan_running() != 0) {
+		_AT_print_error(ERROR_BUSY_SCAN_RUNNING);
+		goto errors;
+	}
+	// Set mode.
+	rs485_status = RS485_set_mode(RS485_MODE_ADDRESSED);
+	RS485_error_check_print();
+	// Perform transaction.
+	rs485_status = RS485_send_transaction((uint8_t) slave_address, (char_t*) &(at_ctx.command[at_ctx.parser.separator_idx + 1]), &transaction);
+	RS485_error_check_print();
+	// Print reply.
+	_AT_reply_add_string("Reply=");
+	_AT_reply_add_string(transaction.reply);
+	_AT_reply_send();
+	// Print status.
+	_AT_reply_add_string("Status=");
+	_AT_reply_add_string(reply_status_name[transaction.reply_status]);
+	if (transaction.reply_status == RS485_REPLY_STATUS_VALUE) {
+		_AT_reply_add_string(" value=");
+		_AT_reply_add_value(transaction.value, STRING_FORMAT_HEXADECIMAL, 1);
+	}
+	_AT_reply_send();
+	// Print turnaround time.
+	_AT_reply_add_string("Time=");
+	_AT_reply_add_value((int32_t) transaction.reply_time_ms, STRING_FORMAT_DECIMAL, 0);
+	_AT_reply_add_string("ms");
+	_AT_reply_send();
+	_AT_print_ok();
+errors:
+	return;
+}
+
+/* AT$BENCH EXECUTION CALLBACK.
+ * @param:	None.
+ * @return:	None.
+ * Note: the board ID register of the node is read count times in a row with the AT$TX transaction (100ms reply timeout),
+ * latency is measured from the end of the command transmission.
+ */
+static void _AT_bench_callback(void) {
+	// Local variables.
+	PARSER_status_t parser_status = PARSER_SUCCESS;
+	RS485_status_t rs485_status = RS485_SUCCESS;
+	RS485_transaction_t transaction;
+	int32_t node_address = 0;
+	int32_t count = 0;
+	uint16_t latency_ms[AT_BENCH_COUNT_MAX];
+	uint16_t latency_tmp = 0;
+	uint8_t reply_count = 0;
+	uint8_t idx = 0;
+	uint8_t sort_idx = 0;
+	uint32_t dropped_frames = RS485_get_rx_dropped_frames();
+	uint32_t bench_start_ms = 0;
+	uint32_t bench_duration_ms = 0;
+#ifdef PWR_STATISTICS
+	uint32_t run_time_ms = PWR_get_state_time_ms(PWR_STATE_RUN);
 #endif
-		break;
-	case DINFOX_REGISTER_SW_VERSION_MAJOR:
-		_AT_reply_add_value(GIT_MAJOR_VERSION, STRING_FORMAT_DECIMAL, 0);
-		break;
-	case DINFOX_REGISTER_SW_VERSION_MINOR:
-		_AT_reply_add_value(GIT_MINOR_VERSION, STRING_FORMAT_DECIMAL, 0);
-		break;
-	case DINFOX_REGISTER_SW_VERSION_COMMIT_INDEX:
-		_AT_reply_add_value(GIT_COMMIT_INDEX, STRING_FORMAT_DECIMAL, 0);
-		break;
-	case DINFOX_REGISTER_SW_VERSION_COMMIT_ID:
-		_AT_reply_add_value(GIT_COMMIT_ID, STRING_FORMAT_HEXADECIMAL, 0);
-		break;
-	case DINFOX_REGISTER_SW_VERSION_DIRTY_FLAG:
-		_AT_reply_add_value(GIT_DIRTY_FLAG, STRING_FORMAT_BOOLEAN, 0);
-		break;
-	case DINFOX_REGISTER_RESET:
-		_AT_reply_add_value((((RCC -> CSR) >> 24) & 0xFF), STRING_FORMAT_HEXADECIMAL, 0);
-		break;
-	case DINFOX_REGISTER_ERROR_STACK:
-		_AT_reply_add_value(ERROR_stack_read(), STRING_FORMAT_HEXADECIMAL, 0);
-		break;
-	case DINFOX_REGISTER_VMCU_MV:
-	case DIM_REGISTER_VUSB_MV:
-	case DIM_REGISTER_VRS_MV:
-		// Perform analog measurements.
-		adc1_status = ADC1_perform_measurements();
-		ADC1_error_check_print();
-		// Note: indexing only works if registers addresses are ordered in the same way as ADC data indexes.
-		adc1_status = ADC1_get_data((register_address - DINFOX_REGISTER_VMCU_MV), &generic_u32);
-		ADC1_error_check_print();
-		_AT_reply_add_value((int32_t) generic_u32, STRING_FORMAT_DECIMAL, 0);
-		break;
-	case DINFOX_REGISTER_TMCU_DEGREES:
-		// Perform analog measurements.
-		adc1_status = ADC1_perform_measurements();
-		ADC1_error_check_print();
-		// Read temperature.
-		adc1_status = ADC1_get_tmcu(&generic_s8);
-		ADC1_error_check_print();
-		_AT_reply_add_value((int32_t) generic_s8, STRING_FORMAT_DECIMAL, 0);
-		break;
-	case DIM_REGISTER_RS485_MODE:
-		_AT_reply_add_value(at_ctx.rs485_mode, STRING_FORMAT_DECIMAL, 0);
-		break;
-	default:
-		_AT_print_error(ERROR_REGISTER_ADDRESS);
+	// Read parameters.
+	parser_status = PARSER_get_parameter(&at_ctx.parser, STRING_FORMAT_HEXADECIMAL, AT_CHAR_SEPARATOR, &node_address);
+	PARSER_error_check_print();
+	parser_status = PARSER_get_parameter(&at_ctx.parser, STRING_FORMAT_DECIMAL, STRING_CHAR_NULL, &count);
+	PARSER_error_check_print();
+	// Check parameters.
+	if ((node_address < 0) || (node_address > RS485_ADDRESS_LAST)) {
+		_AT_print_error(ERROR_RS485_ADDRESS);
+		goto errors;
+	}
+	if ((count <= 0) || (count > AT_BENCH_COUNT_MAX)) {
+		_AT_print_error(ERROR_BENCH_COUNT);
+		goto errors;
+	}
+	// Check if TX is allowed.
+	if (CONFIG_get_tx_mode() == CONFIG_TX_DISABLED) {
+		_AT_print_error(ERROR_TX_DISABLED);
+		goto errors;
+	}
+	if (NODE_is_scan_running() != 0) {
+		_AT_print_error(ERROR_BUSY_SCAN_RUNNING);
 		goto errors;
 	}
-	// Send response.
+	_AT_reply_add_string("RS485 benchmark running...");
+	_AT_reply_send();
+	USART2_flush();
+	// Set mode.
+	rs485_status = RS485_set_mode(RS485_MODE_ADDRESSED);
+	RS485_error_check_print();
+	// Transactions loop.
+	bench_start_ms = RTC_get_time_ms();
+	for (idx=0 ; idx<count ; idx++) {
+		rs485_status = RS485_send_transaction((uint8_t) node_address, AT_BENCH_COMMAND, &transaction);
+		if ((rs485_status == RS485_ERROR_REPLY_TIMEOUT) || (rs485_status == RS485_ERROR_SEQUENCE_TIMEOUT)) continue;
+		RS485_error_check_print();
+		// Insert latency in sorted array.
+		latency_tmp = (uint16_t) transaction.reply_time_ms;
+		for (sort_idx=reply_count ; (sort_idx > 0) && (latency_ms[sort_idx - 1] > latency_tmp) ; sort_idx--) {
+			latency_ms[sort_idx] = latency_ms[sort_idx - 1];
+		}
+		latency_ms[sort_idx] = latency_tmp;
+		reply_count++;
+	}
+	bench_duration_ms = RTC_get_duration_ms(bench_start_ms, RTC_get_time_ms());
+	// Print transactions count.
+	_AT_reply_add_string("Replies=");
+	_AT_reply_add_value((int32_t) reply_count, STRING_FORMAT_DECIMAL, 0);
+	_AT_reply_add_string(" timeouts=");
+	_AT_reply_add_value((int32_t) (count - reply_count), STRING_FORMAT_DECIMAL, 0);
+	_AT_reply_send();
+	// Print rate.
+	_AT_reply_add_string("Rate=");
+	_AT_reply_add_value((int32_t) ((count * 1000) / ((bench_duration_ms == 0) ? 1 : bench_duration_ms)), STRING_FORMAT_DECIMAL, 0);
+	_AT_reply_add_string("cmd/s (");
+	_AT_reply_add_value((int32_t) bench_duration_ms, STRING_FORMAT_DECIMAL, 0);
+	_AT_reply_add_string("ms)");
+	_AT_reply_send();
+	// Print latency distribution.
+	if (reply_count != 0) {
+		_AT_reply_add_string("Latency p50=");
+		_AT_reply_add_value((int32_t) latency_ms[(reply_count - 1) / 2], STRING_FORMAT_DECIMAL, 0);
+		_AT_reply_add_string("ms p99=");
+		_AT_reply_add_value((int32_t) latency_ms[((reply_count * 99) - 1) / 100], STRING_FORMAT_DECIMAL, 0);
+		_AT_reply_add_string("ms max=");
+		_AT_reply_add_value((int32_t) latency_ms[reply_count - 1], STRING_FORMAT_DECIMAL, 0);
+		_AT_reply_add_string("ms");
+		_AT_reply_send();
+	}
+	// Print frames dropped by the reception ring.
+	_AT_reply_add_string("Dropped frames=");
+	_AT_reply_add_value((int32_t) (RS485_get_rx_dropped_frames() - dropped_frames), STRING_FORMAT_DECIMAL, 0);
+	_AT_reply_send();
+#ifdef PWR_STATISTICS
+	// Print CPU load.
+	_AT_reply_add_string("CPU busy=");
+	_AT_reply_add_value((int32_t) (((PWR_get_state_time_ms(PWR_STATE_RUN) - run_time_ms) * 100) / ((bench_duration_ms == 0) ? 1 : bench_duration_ms)), STRING_FORMAT_DECIMAL, 0);
+	_AT_reply_add_string("%");
 	_AT_reply_send();
+#endif
+	_AT_print_ok();
+errors:
+	return;
+}
+
+/* PARSE A REGISTERS LIST (SINGLE ADDRESSES AND RANGES SEPARATED BY COMMAS).
+ * @param register_list:		Array that will contain the registers addresses.
+ * @param number_of_registers:	Pointer that will contain the number of registers in the list.
+ * @return status:				Function execution status.
+ */
+static ERROR_t _AT_parse_register_list(uint8_t* register_list, uint8_t* number_of_registers) {
+	// Local variables.
+	ERROR_t status = SUCCESS;
+	STRING_status_t string_status = STRING_SUCCESS;
+	uint32_t token_start_idx = at_ctx.parser.start_idx;
+	uint32_t token_end_idx = 0;
+	uint32_t range_idx = 0;
+	int32_t first_address = 0;
+	int32_t last_address = 0;
+	int32_t address = 0;
+	// Reset count.
+	(*number_of_registers) = 0;
+	// Tokens loop.
+	while (token_start_idx < at_ctx.command_size) {
+		// Search token end and range separator.
+		range_idx = 0;
+		for (token_end_idx=token_start_idx ; token_end_idx<at_ctx.command_size ; token_end_idx++) {
+			if (at_ctx.command[token_end_idx] == AT_CHAR_SEPARATOR) break;
+			if (at_ctx.command[token_end_idx] == AT_CHAR_RANGE) range_idx = token_end_idx;
+		}
+		// Check empty fields.
+		if ((token_end_idx == token_start_idx) || ((range_idx != 0) && ((range_idx == token_start_idx) || (range_idx == (token_end_idx - 1))))) {
+			status = (ERROR_BASE_PARSER + PARSER_ERROR_PARAMETER_NOT_FOUND);
+			goto errors;
+		}
+		// Convert addresses.
+		if (range_idx == 0) {
+			string_status = STRING_string_to_value((char_t*) &(at_ctx.command[token_start_idx]), STRING_FORMAT_HEXADECIMAL, (token_end_idx - token_start_idx), &first_address);
+			STRING_status_check(ERROR_BASE_STRING);
+			last_address = first_address;
+		}
+		else {
+			string_status = STRING_string_to_value((char_t*) &(at_ctx.command[token_start_idx]), STRING_FORMAT_HEXADECIMAL, (range_idx - token_start_idx), &first_address);
+			STRING_status_check(ERROR_BASE_STRING);
+			string_status = STRING_string_to_value((char_t*) &(at_ctx.command[range_idx + 1]), STRING_FORMAT_HEXADECIMAL, (token_end_idx - range_idx - 1), &last_address);
+			STRING_status_check(ERROR_BASE_STRING);
+		}
+		// Check range.
+		if ((first_address < 0) || (first_address > last_address) || (last_address >= DIM_REGISTER_LAST)) {
+			status = ERROR_REGISTER_ADDRESS;
+			goto errors;
+		}
+		// Append addresses.
+		for (address=first_address ; address<=last_address ; address++) {
+			if ((*number_of_registers) >= AT_REGISTER_LIST_SIZE) {
+				status = ERROR_REGISTER_ADDRESS;
+				goto errors;
+			}
+			register_list[(*number_of_registers)++] = (uint8_t) address;
+		}
+		// Next token.
+		token_start_idx = (token_end_idx + 1);
+	}
+	// Check count.
+	if ((*number_of_registers) == 0) {
+		status = (ERROR_BASE_PARSER + PARSER_ERROR_PARAMETER_NOT_FOUND);
+	}
+errors:
+	return status;
+}
+
+/* AT$R EXECUTION CALLBACK.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _AT_read_callback(void) {
+	// Local variables.
+	ERROR_t status = SUCCESS;
+	uint8_t register_list[AT_REGISTER_LIST_SIZE];
+	int32_t register_values[AT_REGISTER_LIST_SIZE];
+	ERROR_t register_status[AT_REGISTER_LIST_SIZE];
+	uint8_t number_of_registers = 0;
+	uint8_t single_register = 1;
+	uint8_t idx = 0;
+	// Check for list or range syntax.
+	for (idx=at_ctx.parser.start_idx ; idx<at_ctx.command_size ; idx++) {
+		if ((at_ctx.command[idx] == AT_CHAR_SEPARATOR) || (at_ctx.command[idx] == AT_CHAR_RANGE)) {
+			single_register = 0;
+		}
+	}
+	// Read addresses list.
+	status = _AT_parse_register_list(register_list, &number_of_registers);
+	if (status != SUCCESS) {
+		_AT_print_error(status);
+		goto errors;
+	}
+	// Read registers (analog registers share the same measurements).
+	status = DIM_read_registers(register_list, number_of_registers, register_values, register_status);
+	if (status != SUCCESS) {
+		_AT_print_error(status);
+		goto errors;
+	}
+	// Single register: print value only.
+	if (single_register != 0) {
+		if (register_status[0] != SUCCESS) {
+			_AT_print_error(register_status[0]);
+			goto errors;
+		}
+		_AT_reply_add_value(register_values[0], DIM_get_register_format(register_list[0]), 0);
+		_AT_reply_send();
+		goto errors;
+	}
+	// Batch: print one line per register.
+	for (idx=0 ; idx<number_of_registers ; idx++) {
+		// Wait for TX FIFO since the whole batch does not fit in it.
+		USART2_flush();
+		_AT_reply_add_value(register_list[idx], STRING_FORMAT_HEXADECIMAL, 0);
+		_AT_reply_add_string("=");
+		if (register_status[idx] == SUCCESS) {
+			_AT_reply_add_value(register_values[idx], DIM_get_register_format(register_list[idx]), 0);
+			_AT_reply_send();
+		}
+		else {
+			// Error is printed after the address.
+			_AT_print_error(register_status[idx]);
+		}
+	}
+	_AT_print_ok();
 errors:
 	return;
 }
@@ -502,49 +965,59 @@ errors:
 static void _AT_write_callback(void) {
 	// Local variables.
 	PARSER_status_t parser_status = PARSER_SUCCESS;
-	NVM_status_t nvm_status = NVM_SUCCESS;
+	ERROR_t status = SUCCESS;
 	int32_t register_value = 0;
 	int32_t register_address = 0;
 	// Read address parameter.
 	parser_status = PARSER_get_parameter(&at_ctx.parser, STRING_FORMAT_HEXADECIMAL, AT_CHAR_SEPARATOR, &register_address);
 	PARSER_error_check_print();
 	// Check address.
-	if (register_address >= DIM_REGISTER_LAST) {
+	if ((register_address < 0) || (register_address >= DIM_REGISTER_LAST)) {
 		_AT_print_error(ERROR_REGISTER_ADDRESS);
 		goto errors;
 	}
-	// Write data.
-	switch (register_address) {
-	case DINFOX_REGISTER_RS485_ADDRESS:
-		// Read new address.
-		parser_status = PARSER_get_parameter(&at_ctx.parser, STRING_FORMAT_HEXADECIMAL, STRING_CHAR_NULL, &register_value);
-		PARSER_error_check_print();
-		// Check value.
-		if (register_value > RS485_ADDRESS_LAST) {
-			_AT_print_error(ERROR_RS485_ADDRESS);
-			goto errors;
-		}
-		at_ctx.node_address = register_value;
-		nvm_status = NVM_write_byte(NVM_ADDRESS_RS485_ADDRESS, (uint8_t) register_value);
-		NVM_error_check_print();
-		break;
-	case DIM_REGISTER_RS485_MODE:
-		// Read new mode.
-		parser_status = PARSER_get_parameter(&at_ctx.parser, STRING_FORMAT_BOOLEAN, STRING_CHAR_NULL, &register_value);
-		PARSER_error_check_print();
-		// Update mode.
-		at_ctx.rs485_mode = register_value;
-		break;
-	default:
-		_AT_print_error(ERROR_REGISTER_READ_ONLY);
+	// Read value.
+	parser_status = PARSER_get_parameter(&at_ctx.parser, DIM_get_register_format((uint8_t) register_address), STRING_CHAR_NULL, &register_value);
+	PARSER_error_check_print();
+	// Write register.
+	status = DIM_write_register((uint8_t) register_address, register_value);
+	if (status != SUCCESS) {
+		_AT_print_error(status);
 		goto errors;
 	}
+	// Update local address used for printing.
+	if (register_address == DINFOX_REGISTER_RS485_ADDRESS) {
+		at_ctx.node_address = (uint8_t) register_value;
+	}
+	// This line can not confirm the new host baud rate.
+	if (register_address == DIM_REGISTER_HOST_BAUD_RATE) {
+		at_ctx.baud_rate_state = AT_BAUD_RATE_STATE_REQUESTED;
+	}
 	// Operation completed.
 	_AT_print_ok();
 errors:
 	return;
 }
 
+/* AT$BIN EXECUTION CALLBACK.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _AT_binary_mode_callback(void) {
+	// Scan result must be printed in text mode.
+	if (NODE_is_scan_running() != 0) {
+		_AT_print_error(ERROR_BUSY_SCAN_RUNNING);
+		goto errors;
+	}
+	// Acknowledge in text mode and switch.
+	_AT_print_ok();
+	BIN_enable();
+	// Discard pending command lines.
+	at_ctx.rx_read_idx = at_ctx.rx_write_idx;
+errors:
+	return;
+}
+
 /* RESET AT PARSER.
  * @param:	None.
  * @return:	None.
@@ -553,8 +1026,6 @@ static void _AT_reset_parser(void) {
 	// Flush buffers.
 	at_ctx.command_size = 0;
 	at_ctx.reply_size = 0;
-	// Reset flag.
-	at_ctx.line_end_flag = 0;
 	// Reset parser.
 	at_ctx.parser.buffer = (char_t*) at_ctx.command;
 	at_ctx.parser.buffer_size = 0;
@@ -562,33 +1033,187 @@ static void _AT_reset_parser(void) {
 	at_ctx.parser.start_idx = 0;
 }
 
-/* PARSE THE CURRENT AT COMMAND BUFFER.
+/* READ NEXT RECEIVED COMMAND LINE.
+ * @param:	None.
+ * @return:	1 if a line has been copied in the command buffer, 0 if the ring is empty.
+ * Note: a line which did not fit in the command buffer is returned with a zero size.
+ */
+static uint8_t _AT_read_command(void) {
+	// Local variables.
+	uint32_t read_idx = at_ctx.rx_read_idx;
+	uint32_t idx = 0;
+	// Check ring.
+	if (read_idx == at_ctx.rx_write_idx) return 0;
+	// Read length and copy line.
+	at_ctx.command_size = at_ctx.rx_ring[read_idx];
+	read_idx = (read_idx + 1) & (AT_COMMAND_RING_SIZE - 1);
+	for (idx=0 ; idx<at_ctx.command_size ; idx++) {
+		at_ctx.command[idx] = (char_t) at_ctx.rx_ring[read_idx];
+		read_idx = (read_idx + 1) & (AT_COMMAND_RING_SIZE - 1);
+	}
+	at_ctx.command[at_ctx.command_size] = STRING_CHAR_NULL;
+	// Release line.
+	at_ctx.rx_read_idx = read_idx;
+	return 1;
+}
+
+/* COMPUTE DISPATCH KEY HASH.
+ * @param key:		Command or syntax string.
+ * @param key_size:	Maximum number of characters to read.
+ * @return hash:	Hash of the dispatch key (RS485 header, characters up to the header end included or whole string).
+ */
+static uint32_t _AT_hash(char_t* key, uint32_t key_size) {
+	// Local variables.
+	uint32_t hash = 5381;
+	uint32_t idx = 0;
+	// RS485 commands are only identified by their header.
+	if ((key_size > 0) && (key[0] == AT_RS485_COMMAND_HEADER[0])) {
+		key_size = 1;
+	}
+	// Hash characters.
+	for (idx=0 ; idx<key_size ; idx++) {
+		if (key[idx] == STRING_CHAR_NULL) break;
+		hash = ((hash << 5) + hash) ^ ((uint8_t) key[idx]);
+		if (key[idx] == AT_CHAR_HEADER_END) break;
+	}
+	return hash;
+}
+
+/* CHECK IF TWO COMMANDS HAVE THE SAME SYNTAX.
+ * @param syntax_1:	First command syntax.
+ * @param syntax_2:	Second command syntax.
+ * @return:			1 if both strings are identical, 0 otherwise.
+ */
+static uint8_t _AT_is_same_syntax(char_t* syntax_1, char_t* syntax_2) {
+	// Local variables.
+	uint32_t idx = 0;
+	// Compare all characters.
+	while (syntax_1[idx] == syntax_2[idx]) {
+		if (syntax_1[idx] == STRING_CHAR_NULL) return 1;
+		idx++;
+	}
+	return 0;
+}
+
+/* BUILD COMMANDS DISPATCH TABLE.
  * @param:	None.
  * @return:	None.
+ * Note: commands sharing the same syntax are only registered once, the first entry of the list is used (same as sequential search).
+ * Different commands whose keys collide are all registered and told apart by the parser at decode time.
+ */
+static void _AT_build_hash_table(void) {
+	// Local variables.
+	uint32_t idx = 0;
+	uint32_t slot = 0;
+	// Reset table.
+	for (idx=0 ; idx<AT_HASH_TABLE_SIZE ; idx++) {
+		at_hash_table[idx] = AT_HASH_TABLE_EMPTY;
+	}
+	// Insert commands with linear probing.
+	for (idx=0 ; idx<(sizeof(AT_COMMAND_LIST) / sizeof(AT_command_t)) ; idx++) {
+		slot = _AT_hash(AT_COMMAND_LIST[idx].syntax, AT_COMMAND_BUFFER_SIZE) & (AT_HASH_TABLE_SIZE - 1);
+		while (at_hash_table[slot] != AT_HASH_TABLE_EMPTY) {
+			// Skip duplicated syntax.
+			if (_AT_is_same_syntax(AT_COMMAND_LIST[at_hash_table[slot]].syntax, AT_COMMAND_LIST[idx].syntax) != 0) break;
+			slot = (slot + 1) & (AT_HASH_TABLE_SIZE - 1);
+		}
+		if (at_hash_table[slot] == AT_HASH_TABLE_EMPTY) {
+			at_hash_table[slot] = (uint8_t) idx;
+		}
+	}
+}
+
+/* PARSE THE CURRENT AT COMMAND BUFFER.
+ * @param:	None.
+ * @return:	1 if the command has been recognized, 0 otherwise.
  */
-static void _AT_decode(void) {
+static uint8_t _AT_decode(void) {
 	// Local variables.
 	uint8_t idx = 0;
 	uint8_t decode_success = 0;
+	uint32_t slot = 0;
 	// Update parser length.
 	at_ctx.parser.buffer_size = at_ctx.command_size;
-	// Loop on available commands.
-	for (idx=0 ; idx<(sizeof(AT_COMMAND_LIST) / sizeof(AT_command_t)) ; idx++) {
-		// Check type.
+	// Search command in dispatch table.
+	PROF_enter(PROF_PROBE_AT_DECODE);
+	slot = _AT_hash((char_t*) at_ctx.command, at_ctx.command_size) & (AT_HASH_TABLE_SIZE - 1);
+	while (at_hash_table[slot] != AT_HASH_TABLE_EMPTY) {
+		idx = at_hash_table[slot];
+		// Confirm match.
 		if (PARSER_compare(&at_ctx.parser, AT_COMMAND_LIST[idx].mode, AT_COMMAND_LIST[idx].syntax) == PARSER_SUCCESS) {
-			// Execute callback and exit.
+			// Execute callback and exit (callback duration is not part of the decode probe).
+			PROF_exit(PROF_PROBE_AT_DECODE);
 			AT_COMMAND_LIST[idx].callback();
 			decode_success = 1;
 			break;
 		}
+		slot = (slot + 1) & (AT_HASH_TABLE_SIZE - 1);
 	}
 	if (decode_success == 0) {
+		PROF_exit(PROF_PROBE_AT_DECODE);
 		_AT_print_error(ERROR_BASE_PARSER + PARSER_ERROR_UNKNOWN_COMMAND); // Unknown command.
 		goto errors;
 	}
 errors:
 	_AT_reset_parser();
-	return;
+	return decode_success;
+}
+
+/* MANAGE HOST BAUD RATE SWITCH HANDSHAKE.
+ * @param line_decoded:	1 if a valid command has just been decoded, 0 otherwise.
+ * @return:				None.
+ * Note: a new baud rate is saved in NVM only once a valid command has been received with it,
+ * otherwise the previous baud rate is restored after a timeout so that the host can always recover the link.
+ * Lines stored in the ring before the switch (including the one which requested it) can not confirm the new baud rate.
+ */
+static void _AT_manage_baud_rate(uint8_t line_decoded) {
+	// Local variables.
+	NVM_status_t nvm_status = NVM_SUCCESS;
+	// Check state.
+	switch (at_ctx.baud_rate_state) {
+	case AT_BAUD_RATE_STATE_IDLE:
+		// Switch requested by another interface (binary mode).
+		if (USART2_get_baud_rate_status() != USART_BAUD_RATE_STATUS_CONFIRMED) {
+			at_ctx.baud_rate_state = AT_BAUD_RATE_STATE_REQUESTED;
+		}
+		break;
+	case AT_BAUD_RATE_STATE_REQUESTED:
+		// Wait for the reply to be sent so that lines already in the ring are known to be received before the switch.
+		USART2_flush();
+		if (USART2_get_baud_rate_status() == USART_BAUD_RATE_STATUS_PENDING) break;
+		if (USART2_get_baud_rate_status() == USART_BAUD_RATE_STATUS_CONFIRMED) {
+			// Baud rate was not changed.
+			at_ctx.baud_rate_state = AT_BAUD_RATE_STATE_IDLE;
+			break;
+		}
+		// Start confirmation window.
+		at_ctx.baud_rate_switch_time_ms = RTC_get_time_ms();
+		at_ctx.baud_rate_switch_ring_idx = at_ctx.rx_write_idx;
+		at_ctx.baud_rate_state = AT_BAUD_RATE_STATE_SWITCHED;
+		break;
+	case AT_BAUD_RATE_STATE_AWAITING_CONFIRMATION:
+		if (line_decoded != 0) {
+			// Host is able to communicate with the new baud rate.
+			USART2_confirm_baud_rate();
+			nvm_status = NVM_write_word(NVM_ADDRESS_HOST_BAUD_RATE, USART2_get_baud_rate());
+			NVM_error_check();
+			at_ctx.baud_rate_state = AT_BAUD_RATE_STATE_IDLE;
+		}
+		break;
+	default:
+		// Nothing to do.
+		break;
+	}
+	// Check if all lines received before the switch have been read.
+	if ((at_ctx.baud_rate_state == AT_BAUD_RATE_STATE_SWITCHED) && (at_ctx.rx_read_idx == at_ctx.baud_rate_switch_ring_idx)) {
+		at_ctx.baud_rate_state = AT_BAUD_RATE_STATE_AWAITING_CONFIRMATION;
+	}
+	// Check timeout.
+	if (((at_ctx.baud_rate_state == AT_BAUD_RATE_STATE_SWITCHED) || (at_ctx.baud_rate_state == AT_BAUD_RATE_STATE_AWAITING_CONFIRMATION)) && (RTC_get_duration_ms(at_ctx.baud_rate_switch_time_ms, RTC_get_time_ms()) >= AT_BAUD_RATE_CONFIRMATION_TIMEOUT_MS)) {
+		// Fall back to previous baud rate.
+		USART2_revert_baud_rate();
+		at_ctx.baud_rate_state = AT_BAUD_RATE_STATE_IDLE;
+	}
 }
 
 /*** AT functions ***/
@@ -600,14 +1225,27 @@ errors:
 void AT_init(void) {
 	// Local variables.
 	NVM_status_t nvm_status = NVM_SUCCESS;
+	NODE_status_t node_status = NODE_SUCCESS;
 	// Read RS485 address for printing.
 	nvm_status = NVM_read_byte(NVM_ADDRESS_RS485_ADDRESS, &at_ctx.node_address);
 	NVM_error_check();
+	// Load nodes table.
+	node_status = NODE_init();
+	NODE_error_check();
 	// Init context.
+	at_ctx.rx_write_idx = 0;
+	at_ctx.rx_read_idx = 0;
+	at_ctx.rx_line_start_idx = 0;
+	at_ctx.rx_line_size = 0;
+	at_ctx.rx_line_overflow = 0;
+	at_ctx.baud_rate_state = AT_BAUD_RATE_STATE_IDLE;
+	at_ctx.baud_rate_switch_time_ms = 0;
+	at_ctx.baud_rate_switch_ring_idx = 0;
+	at_ctx.scan_start_ms = 0;
 	_AT_reset_parser();
-	at_ctx.rs485_mode = RS485_MODE_ADDRESSED;
+	_AT_build_hash_table();
 	// Start continuous listening.
-	RS485_set_mode(at_ctx.rs485_mode);
+	RS485_set_mode(RS485_MODE_ADDRESSED);
 	RS485_init();
 	// Enable USART.
 	USART2_enable_interrupt();
@@ -616,17 +1254,55 @@ void AT_init(void) {
 /* MAIN TASK OF AT COMMAND MANAGER.
  * @param:	None.
  * @return:	None.
+ * Note: called when a command line or a binary frame has been received, and periodically to check the baud rate confirmation timeout.
  */
 void AT_task(void) {
-	// Trigger decoding function if line end found.
-	if (at_ctx.line_end_flag != 0) {
-		// Decode and execute command.
-		USART2_disable_interrupt();
-		_AT_decode();
-		USART2_enable_interrupt();
+	// Local variables.
+	uint8_t line_decoded = 0;
+	// Check host interface mode.
+	if (BIN_is_enabled() != 0) {
+		BIN_task();
 	}
-	// Perform continuous listening task.
-	RS485_task();
+	else {
+		// Execute all pending command lines in reception order.
+		while ((BIN_is_enabled() == 0) && (_AT_read_command() != 0)) {
+			if (at_ctx.command_size == 0) {
+				_AT_print_error(ERROR_COMMAND_OVERFLOW);
+				_AT_reset_parser();
+			}
+			else {
+				line_decoded = _AT_decode();
+				_AT_manage_baud_rate(line_decoded);
+			}
+			IWDG_reload();
+		}
+	}
+	// Check host baud rate confirmation timeout.
+	_AT_manage_baud_rate(0);
+}
+
+/* RESUMABLE SCAN TASK.
+ * @param:	None.
+ * @return:	None.
+ * Note: one address is probed at each call, the task is scheduled again until the end of the range.
+ */
+void AT_scan_task(void) {
+	// Local variables.
+	NODE_status_t node_status = NODE_SUCCESS;
+	// Check state.
+	if (NODE_is_scan_running() == 0) goto errors;
+	// Probe next address.
+	node_status = NODE_scan_step();
+	NODE_error_check_print();
+	// Reschedule or print result.
+	if (NODE_is_scan_running() != 0) {
+		EVENT_post(EVENT_NODE_SCAN);
+	}
+	else {
+		_AT_print_scan_result();
+	}
+errors:
+	return;
 }
 
 /* PRINT AN RS485 REPLY OVER AT INTERFACE.
@@ -649,8 +1325,12 @@ void AT_print_rs485_frame(char_t* rs485_frame, uint8_t rs485_frame_size) {
 	// Local variables.
 	uint8_t source_address = 0;
 	uint8_t destination_address = 0;
+	// Check host interface mode.
+	if (BIN_is_enabled() != 0) {
+		BIN_send_rs485_frame(rs485_frame, rs485_frame_size);
+	}
 	// Check parsing mode.
-	if (at_ctx.rs485_mode == RS485_MODE_DIRECT) {
+	else if (RS485_get_mode() == RS485_MODE_DIRECT) {
 		_AT_reply_add_string(rs485_frame);
 		_AT_reply_send();
 	}
@@ -672,23 +1352,49 @@ void AT_print_rs485_frame(char_t* rs485_frame, uint8_t rs485_frame_size) {
 	}
 }
 
-/* FILL AT COMMAND BUFFER WITH A NEW BYTE (CALLED BY USART INTERRUPT).
+/* FILL AT COMMAND RING WITH A NEW BYTE (CALLED BY USART INTERRUPT).
  * @param rx_byte:	Incoming byte.
  * @return:			None.
  */
 void AT_fill_rx_buffer(uint8_t rx_byte) {
-	// Append byte if line end flag is not allready set.
-	if (at_ctx.line_end_flag == 0) {
-		// Check ending characters.
-		if ((rx_byte == STRING_CHAR_CR) || (rx_byte == STRING_CHAR_LF)) {
-			at_ctx.command[at_ctx.command_size] = STRING_CHAR_NULL;
-			at_ctx.line_end_flag = 1;
+	// Local variables.
+	uint32_t write_idx = 0;
+	uint32_t free_size = 0;
+	// Compute ring space after the line start (one byte is kept free to distinguish full and empty states).
+	free_size = (at_ctx.rx_read_idx - at_ctx.rx_line_start_idx - 1) & (AT_COMMAND_RING_SIZE - 1);
+	// Forward byte to binary protocol if enabled.
+	if (BIN_is_enabled() != 0) {
+		BIN_fill_rx_buffer(rx_byte);
+	}
+	// Check ending characters.
+	else if ((rx_byte == STRING_CHAR_CR) || (rx_byte == STRING_CHAR_LF)) {
+		// Commit line (empty lines are ignored, a line which did not fit is committed with a zero size).
+		if ((at_ctx.rx_line_size != 0) || (at_ctx.rx_line_overflow != 0)) {
+			if (at_ctx.rx_line_overflow != 0) {
+				at_ctx.rx_line_size = 0;
+			}
+			write_idx = (at_ctx.rx_line_start_idx + 1 + at_ctx.rx_line_size) & (AT_COMMAND_RING_SIZE - 1);
+			if (free_size >= (1 + (uint32_t) at_ctx.rx_line_size)) {
+				at_ctx.rx_ring[at_ctx.rx_line_start_idx] = at_ctx.rx_line_size;
+				at_ctx.rx_write_idx = write_idx;
+				EVENT_post(EVENT_HOST_RX);
+			}
 		}
-		else {
-			// Store new byte.
-			at_ctx.command[at_ctx.command_size] = rx_byte;
-			// Manage index.
-			at_ctx.command_size = (at_ctx.command_size + 1) % AT_COMMAND_BUFFER_SIZE;
+		// Start next line.
+		at_ctx.rx_line_start_idx = at_ctx.rx_write_idx;
+		at_ctx.rx_line_size = 0;
+		at_ctx.rx_line_overflow = 0;
+	}
+	else {
+		// Check line size and ring space (length byte, stored data and incoming byte).
+		write_idx = (at_ctx.rx_line_start_idx + 1 + at_ctx.rx_line_size) & (AT_COMMAND_RING_SIZE - 1);
+		if ((at_ctx.rx_line_size >= (AT_COMMAND_BUFFER_SIZE - 1)) || (free_size < (2 + (uint32_t) at_ctx.rx_line_size))) {
+			at_ctx.rx_line_overflow = 1;
+		}
+		if (at_ctx.rx_line_overflow == 0) {
+			// Store incoming byte.
+			at_ctx.rx_ring[write_idx] = rx_byte;
+			at_ctx.rx_line_size++;
 		}
 	}
 }
@@ -0,0 +1,439 @@
+/*
+ * bin.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "bin.h"
+
+#include "config.h"
+#include "dim.h"
+#include "error.h"
+#include "event.h"
+#include "node.h"
+#include "rs485.h"
+#include "rs485_common.h"
+#include "rtc.h"
+#include "string.h"
+#include "types.h"
+#include "usart.h"
+
+/*** BIN local macros ***/
+
+// Frame format: SYNC | LENGTH | TYPE | PAYLOAD (LENGTH bytes) | CRC16 (MSB first, computed on LENGTH, TYPE and PAYLOAD).
+#define BIN_SYNC						0xA5
+#define BIN_PAYLOAD_SIZE_MAX			80
+#define BIN_FRAME_OVERHEAD_SIZE_BYTES	5
+#define BIN_CRC16_POLYNOMIAL			0x1021
+#define BIN_CRC16_INIT					0xFFFF
+// Reply type is the request type with MSB set.
+#define BIN_TYPE_REPLY_FLAG				0x80
+// Sniffed RS485 frame type with LSB set when the frame did not fit in the payload (only the first bytes are sent).
+#define BIN_TYPE_TRUNCATED_FLAG			0x01
+// Reception restarts on the next sync byte when the gap between two bytes of a frame reaches this value (1 second resolution).
+#define BIN_RX_TIMEOUT_SECONDS			2
+// Direct mode destination address.
+#define BIN_RS485_ADDRESS_NONE			0xFF
+
+/*** BIN local structures ***/
+
+typedef enum {
+	BIN_TYPE_TEXT_MODE = 0x00,
+	BIN_TYPE_READ_REGISTER,
+	BIN_TYPE_WRITE_REGISTER,
+	BIN_TYPE_RS485_COMMAND,
+	BIN_TYPE_SCAN,
+	BIN_TYPE_RS485_FRAME = 0x90,
+	BIN_TYPE_ERROR = 0xFF
+} BIN_type_t;
+
+typedef enum {
+	BIN_RX_STATE_SYNC = 0,
+	BIN_RX_STATE_LENGTH,
+	BIN_RX_STATE_TYPE,
+	BIN_RX_STATE_PAYLOAD,
+	BIN_RX_STATE_CRC_MSB,
+	BIN_RX_STATE_CRC_LSB,
+	BIN_RX_STATE_LAST
+} BIN_rx_state_t;
+
+typedef struct {
+	volatile uint8_t enabled;
+	// Reception.
+	volatile BIN_rx_state_t rx_state;
+	volatile uint8_t rx_type;
+	volatile uint8_t rx_payload[BIN_PAYLOAD_SIZE_MAX];
+	volatile uint8_t rx_payload_size;
+	volatile uint8_t rx_idx;
+	volatile uint16_t rx_crc;
+	volatile uint8_t rx_frame_flag;
+	volatile uint32_t rx_byte_time_s;
+	// Transmission.
+	uint8_t tx_frame[BIN_PAYLOAD_SIZE_MAX + BIN_FRAME_OVERHEAD_SIZE_BYTES];
+	uint8_t tx_payload_size;
+} BIN_context_t;
+
+/*** BIN local global variables ***/
+
+static BIN_context_t bin_ctx;
+
+/*** BIN local functions ***/
+
+/* UPDATE CRC16 WITH A NEW BYTE (CCITT POLYNOMIAL).
+ * @param crc:	Current CRC value.
+ * @param data:	New byte.
+ * @return crc:	Updated CRC value.
+ */
+static uint16_t _BIN_crc16_update(uint16_t crc, uint8_t data) {
+	// Local variables.
+	uint8_t bit_idx = 0;
+	crc ^= ((uint16_t) data) << 8;
+	for (bit_idx=0 ; bit_idx<8 ; bit_idx++) {
+		crc = ((crc & 0x8000) != 0) ? ((crc << 1) ^ BIN_CRC16_POLYNOMIAL) : (crc << 1);
+	}
+	return crc;
+}
+
+/* GENERIC MACRO TO ADD A BYTE TO THE REPLY PAYLOAD.
+ * @param byte:	Byte to add.
+ * @return:		None.
+ */
+#define _BIN_reply_add_byte(byte) { \
+	if (bin_ctx.tx_payload_size < BIN_PAYLOAD_SIZE_MAX) { \
+		bin_ctx.tx_frame[3 + bin_ctx.tx_payload_size] = (uint8_t) (byte); \
+		bin_ctx.tx_payload_size++; \
+	} \
+}
+
+/* START A NEW REPLY FRAME.
+ * @param type:	Frame type.
+ * @return:		None.
+ */
+static void _BIN_reply_start(uint8_t type) {
+	bin_ctx.tx_frame[0] = BIN_SYNC;
+	bin_ctx.tx_frame[2] = type;
+	bin_ctx.tx_payload_size = 0;
+}
+
+/* APPEND A 16-BITS STATUS TO THE REPLY PAYLOAD.
+ * @param status:	Status to add.
+ * @return:			None.
+ */
+static void _BIN_reply_add_status(ERROR_t status) {
+	_BIN_reply_add_byte(((uint32_t) status) >> 8);
+	_BIN_reply_add_byte(((uint32_t) status) >> 0);
+}
+
+/* FINALIZE AND SEND REPLY FRAME.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _BIN_reply_send(void) {
+	// Local variables.
+	USART_status_t usart_status = USART_SUCCESS;
+	uint16_t crc = BIN_CRC16_INIT;
+	uint8_t idx = 0;
+	// Length.
+	bin_ctx.tx_frame[1] = bin_ctx.tx_payload_size;
+	// CRC.
+	for (idx=1 ; idx<(3 + bin_ctx.tx_payload_size) ; idx++) {
+		crc = _BIN_crc16_update(crc, bin_ctx.tx_frame[idx]);
+	}
+	bin_ctx.tx_frame[3 + bin_ctx.tx_payload_size] = (uint8_t) (crc >> 8);
+	bin_ctx.tx_frame[4 + bin_ctx.tx_payload_size] = (uint8_t) (crc >> 0);
+	// Send frame.
+	usart_status = USART2_send_bytes(bin_ctx.tx_frame, (bin_ctx.tx_payload_size + BIN_FRAME_OVERHEAD_SIZE_BYTES));
+	USART_error_check();
+}
+
+/* SEND AN ERROR FRAME.
+ * @param status:	Error to send.
+ * @return:			None.
+ */
+static void _BIN_send_error(ERROR_t status) {
+	ERROR_stack_add(status);
+	_BIN_reply_start(BIN_TYPE_ERROR);
+	_BIN_reply_add_status(status);
+	_BIN_reply_send();
+}
+
+/* READ REGISTER REQUEST.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _BIN_read_register(void) {
+	// Local variables.
+	ERROR_t status = SUCCESS;
+	int32_t register_value = 0;
+	// Check length.
+	if (bin_ctx.rx_payload_size != 1) {
+		_BIN_send_error(ERROR_BASE_PARSER + PARSER_ERROR_BYTE_ARRAY_SIZE);
+		goto errors;
+	}
+	// Read register.
+	status = DIM_read_register(bin_ctx.rx_payload[0], &register_value);
+	// Build reply.
+	_BIN_reply_start(BIN_TYPE_READ_REGISTER | BIN_TYPE_REPLY_FLAG);
+	_BIN_reply_add_byte(bin_ctx.rx_payload[0]);
+	_BIN_reply_add_status(status);
+	_BIN_reply_add_byte(((uint32_t) register_value) >> 24);
+	_BIN_reply_add_byte(((uint32_t) register_value) >> 16);
+	_BIN_reply_add_byte(((uint32_t) register_value) >> 8);
+	_BIN_reply_add_byte(((uint32_t) register_value) >> 0);
+	_BIN_reply_send();
+errors:
+	return;
+}
+
+/* WRITE REGISTER REQUEST.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _BIN_write_register(void) {
+	// Local variables.
+	ERROR_t status = SUCCESS;
+	int32_t register_value = 0;
+	// Check length.
+	if (bin_ctx.rx_payload_size != 5) {
+		_BIN_send_error(ERROR_BASE_PARSER + PARSER_ERROR_BYTE_ARRAY_SIZE);
+		goto errors;
+	}
+	// Write register.
+	register_value = (int32_t) ((bin_ctx.rx_payload[1] << 24) | (bin_ctx.rx_payload[2] << 16) | (bin_ctx.rx_payload[3] << 8) | (bin_ctx.rx_payload[4] << 0));
+	status = DIM_write_register(bin_ctx.rx_payload[0], register_value);
+	// Build reply.
+	_BIN_reply_start(BIN_TYPE_WRITE_REGISTER | BIN_TYPE_REPLY_FLAG);
+	_BIN_reply_add_byte(bin_ctx.rx_payload[0]);
+	_BIN_reply_add_status(status);
+	_BIN_reply_send();
+errors:
+	return;
+}
+
+/* RS485 COMMAND REQUEST.
+ * @param:	None.
+ * @return:	None.
+ * Note: replies are streamed as RS485 frames.
+ */
+static void _BIN_send_rs485_command(void) {
+	// Local variables.
+	ERROR_t status = SUCCESS;
+	RS485_status_t rs485_status = RS485_SUCCESS;
+	char_t command[BIN_PAYLOAD_SIZE_MAX];
+	uint8_t idx = 0;
+	// Check length.
+	if (bin_ctx.rx_payload_size < 2) {
+		status = (ERROR_BASE_PARSER + PARSER_ERROR_BYTE_ARRAY_SIZE);
+		goto errors;
+	}
+	// Check if TX is allowed.
+	if (CONFIG_get_tx_mode() == CONFIG_TX_DISABLED) {
+		status = ERROR_TX_DISABLED;
+		goto errors;
+	}
+	// Copy command.
+	for (idx=1 ; idx<bin_ctx.rx_payload_size ; idx++) {
+		command[idx - 1] = (char_t) bin_ctx.rx_payload[idx];
+	}
+	command[bin_ctx.rx_payload_size - 1] = STRING_CHAR_NULL;
+	// Set mode and send command.
+	rs485_status = RS485_set_mode((bin_ctx.rx_payload[0] == BIN_RS485_ADDRESS_NONE) ? RS485_MODE_DIRECT : RS485_MODE_ADDRESSED);
+	RS485_status_check(ERROR_BASE_RS485);
+	rs485_status = RS485_send_command((bin_ctx.rx_payload[0] & RS485_ADDRESS_MASK), command);
+	RS485_status_check(ERROR_BASE_RS485);
+errors:
+	_BIN_reply_start(BIN_TYPE_RS485_COMMAND | BIN_TYPE_REPLY_FLAG);
+	_BIN_reply_add_status(status);
+	_BIN_reply_send();
+}
+
+/* SCAN REQUEST.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _BIN_scan(void) {
+	// Local variables.
+	ERROR_t status = SUCCESS;
+	NODE_status_t node_status = NODE_SUCCESS;
+	NODE_t node;
+	RS485_address_t first_address = 0;
+	RS485_address_t last_address = RS485_ADDRESS_LAST;
+	uint8_t idx = 0;
+	// Read optional range.
+	if (bin_ctx.rx_payload_size == 2) {
+		first_address = bin_ctx.rx_payload[0];
+		last_address = bin_ctx.rx_payload[1];
+	}
+	else if (bin_ctx.rx_payload_size != 0) {
+		status = (ERROR_BASE_PARSER + PARSER_ERROR_BYTE_ARRAY_SIZE);
+		goto errors;
+	}
+	if ((first_address > last_address) || (last_address > RS485_ADDRESS_LAST)) {
+		status = ERROR_RS485_ADDRESS;
+		goto errors;
+	}
+	// Check if TX is allowed.
+	if (CONFIG_get_tx_mode() == CONFIG_TX_DISABLED) {
+		status = ERROR_TX_DISABLED;
+		goto errors;
+	}
+	// Perform scan.
+	node_status = NODE_scan(first_address, last_address);
+	NODE_status_check(ERROR_BASE_NODE);
+errors:
+	// Build reply.
+	_BIN_reply_start(BIN_TYPE_SCAN | BIN_TYPE_REPLY_FLAG);
+	_BIN_reply_add_status(status);
+	_BIN_reply_add_byte(NODE_get_count());
+	for (idx=0 ; idx<NODE_get_count() ; idx++) {
+		if (NODE_get(idx, &node) != NODE_SUCCESS) break;
+		_BIN_reply_add_byte(node.node.address);
+		_BIN_reply_add_byte(node.node.board_id);
+		_BIN_reply_add_byte(node.node.reply_time_ms >> 8);
+		_BIN_reply_add_byte(node.node.reply_time_ms >> 0);
+	}
+	_BIN_reply_send();
+}
+
+/* RESET RECEPTION STATE MACHINE.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _BIN_reset_rx(void) {
+	bin_ctx.rx_state = BIN_RX_STATE_SYNC;
+	bin_ctx.rx_frame_flag = 0;
+}
+
+/*** BIN functions ***/
+
+/* SWITCH HOST INTERFACE TO BINARY MODE.
+ * @param:	None.
+ * @return:	None.
+ */
+void BIN_enable(void) {
+	_BIN_reset_rx();
+	bin_ctx.enabled = 1;
+}
+
+/* GET BINARY MODE STATUS.
+ * @param:	None.
+ * @return:	1 if the binary mode is enabled, 0 otherwise (AT text mode).
+ */
+uint8_t BIN_is_enabled(void) {
+	return bin_ctx.enabled;
+}
+
+/* MAIN TASK OF BINARY PROTOCOL.
+ * @param:	None.
+ * @return:	None.
+ */
+void BIN_task(void) {
+	// Check frame flag.
+	if (bin_ctx.rx_frame_flag == 0) goto errors;
+	// Check CRC.
+	if (bin_ctx.rx_crc != 0) {
+		_BIN_send_error(ERROR_BIN_CRC);
+		goto errors;
+	}
+	// Decode frame.
+	switch (bin_ctx.rx_type) {
+	case BIN_TYPE_TEXT_MODE:
+		_BIN_reply_start(BIN_TYPE_TEXT_MODE | BIN_TYPE_REPLY_FLAG);
+		_BIN_reply_add_status(SUCCESS);
+		_BIN_reply_send();
+		bin_ctx.enabled = 0;
+		break;
+	case BIN_TYPE_READ_REGISTER:
+		_BIN_read_register();
+		break;
+	case BIN_TYPE_WRITE_REGISTER:
+		_BIN_write_register();
+		break;
+	case BIN_TYPE_RS485_COMMAND:
+		_BIN_send_rs485_command();
+		break;
+	case BIN_TYPE_SCAN:
+		_BIN_scan();
+		break;
+	default:
+		_BIN_send_error(ERROR_BASE_PARSER + PARSER_ERROR_UNKNOWN_COMMAND);
+		break;
+	}
+errors:
+	if (bin_ctx.rx_frame_flag != 0) {
+		_BIN_reset_rx();
+	}
+	return;
+}
+
+/* SEND A SNIFFED RS485 FRAME.
+ * @param rs485_frame:		Raw frame.
+ * @param rs485_frame_size:	Size of the frame.
+ * @return:					None.
+ */
+void BIN_send_rs485_frame(char_t* rs485_frame, uint8_t rs485_frame_size) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Build frame (truncation is flagged in the type field).
+	_BIN_reply_start((rs485_frame_size > BIN_PAYLOAD_SIZE_MAX) ? (BIN_TYPE_RS485_FRAME | BIN_TYPE_TRUNCATED_FLAG) : BIN_TYPE_RS485_FRAME);
+	for (idx=0 ; idx<rs485_frame_size ; idx++) {
+		_BIN_reply_add_byte(rs485_frame[idx]);
+	}
+	_BIN_reply_send();
+}
+
+/* FILL BINARY FRAME BUFFER WITH A NEW BYTE (CALLED BY USART INTERRUPT).
+ * @param rx_byte:	Incoming byte.
+ * @return:			None.
+ */
+void BIN_fill_rx_buffer(uint8_t rx_byte) {
+	// Local variables.
+	uint32_t time_s = 0;
+	// Ignore bytes while the previous frame is not processed.
+	if (bin_ctx.rx_frame_flag != 0) return;
+	// Drop frame being received if the host stopped sending in the middle of it.
+	time_s = RTC_get_time_seconds();
+	if ((bin_ctx.rx_state != BIN_RX_STATE_SYNC) && (RTC_get_duration_ms((bin_ctx.rx_byte_time_s * 1000), (time_s * 1000)) >= (BIN_RX_TIMEOUT_SECONDS * 1000))) {
+		bin_ctx.rx_state = BIN_RX_STATE_SYNC;
+	}
+	bin_ctx.rx_byte_time_s = time_s;
+	// Update CRC.
+	bin_ctx.rx_crc = _BIN_crc16_update(bin_ctx.rx_crc, rx_byte);
+	// Reception state machine.
+	switch (bin_ctx.rx_state) {
+	case BIN_RX_STATE_SYNC:
+		if (rx_byte == BIN_SYNC) {
+			bin_ctx.rx_crc = BIN_CRC16_INIT;
+			bin_ctx.rx_state = BIN_RX_STATE_LENGTH;
+		}
+		break;
+	case BIN_RX_STATE_LENGTH:
+		bin_ctx.rx_payload_size = rx_byte;
+		bin_ctx.rx_idx = 0;
+		bin_ctx.rx_state = (rx_byte > BIN_PAYLOAD_SIZE_MAX) ? BIN_RX_STATE_SYNC : BIN_RX_STATE_TYPE;
+		break;
+	case BIN_RX_STATE_TYPE:
+		bin_ctx.rx_type = rx_byte;
+		bin_ctx.rx_state = (bin_ctx.rx_payload_size == 0) ? BIN_RX_STATE_CRC_MSB : BIN_RX_STATE_PAYLOAD;
+		break;
+	case BIN_RX_STATE_PAYLOAD:
+		bin_ctx.rx_payload[bin_ctx.rx_idx] = rx_byte;
+		bin_ctx.rx_idx++;
+		if (bin_ctx.rx_idx >= bin_ctx.rx_payload_size) {
+			bin_ctx.rx_state = BIN_RX_STATE_CRC_MSB;
+		}
+		break;
+	case BIN_RX_STATE_CRC_MSB:
+		bin_ctx.rx_state = BIN_RX_STATE_CRC_LSB;
+		break;
+	case BIN_RX_STATE_CRC_LSB:
+		// Frame complete: CRC register is null if the frame is valid.
+		bin_ctx.rx_frame_flag = 1;
+		EVENT_post(EVENT_HOST_RX);
+		break;
+	default:
+		bin_ctx.rx_state = BIN_RX_STATE_SYNC;
+		break;
+	}
+}
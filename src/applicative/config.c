@@ -13,26 +13,54 @@
 
 /*** CONFIG local macros ***/
 
-#define GPIO_TX_MODE		GPIO_MODE0
+#define GPIO_TX_MODE						GPIO_MODE0
+#define CONFIG_SWITCH_SETTLING_TIME_MS		10
+#define CONFIG_SWITCH_DEBOUNCE_SAMPLES		3
+#define CONFIG_SWITCH_DEBOUNCE_PERIOD_MS	5
+
+/*** CONFIG local global variables ***/
+
+static CONFIG_tx_mode_t config_tx_mode = CONFIG_TX_DISABLED;
 
 /*** CONFIG functions ***/
 
+/* INIT DIP SWITCH MONITORING.
+ * @param:	None.
+ * @return:	None.
+ */
+void CONFIG_init(void) {
+	// Read initial state.
+	CONFIG_update_tx_mode();
+}
+
 /* READ TX MODE ON DIP SWITCH.
  * @param:			None.
  * @return tx_mode:	Current TX mode.
  */
 CONFIG_tx_mode_t CONFIG_get_tx_mode(void) {
+	return config_tx_mode;
+}
+
+/* UPDATE TX MODE FROM DIP SWITCH (CALLED ON RTC WAKE-UP EVENT).
+ * @param:	None.
+ * @return:	None.
+ * Note: the pull-up is only enabled during sampling, the cached mode is kept if the samples do not match (switch bouncing).
+ */
+void CONFIG_update_tx_mode(void) {
 	// Local variables.
-	CONFIG_tx_mode_t tx_mode = CONFIG_TX_DISABLED;
+	uint8_t gpio_state = 0;
+	uint8_t idx = 0;
 	// Activate pull up.
 	GPIO_configure(&GPIO_TX_MODE, GPIO_MODE_INPUT, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_UP);
-	LPTIM1_delay_milliseconds(100, 0);
-	// Read GPIO.
-	if (GPIO_read(&GPIO_TX_MODE) == 0) {
-		tx_mode = CONFIG_TX_ENABLED;
+	LPTIM1_delay_milliseconds(CONFIG_SWITCH_SETTLING_TIME_MS, 0);
+	// Read GPIO until all samples match.
+	gpio_state = GPIO_read(&GPIO_TX_MODE);
+	for (idx=1 ; idx<CONFIG_SWITCH_DEBOUNCE_SAMPLES ; idx++) {
+		LPTIM1_delay_milliseconds(CONFIG_SWITCH_DEBOUNCE_PERIOD_MS, 0);
+		if (GPIO_read(&GPIO_TX_MODE) != gpio_state) goto errors;
 	}
+	config_tx_mode = (gpio_state == 0) ? CONFIG_TX_ENABLED : CONFIG_TX_DISABLED;
+errors:
 	// Disable pull-up.
 	GPIO_configure(&GPIO_TX_MODE, GPIO_MODE_ANALOG, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_LOW, GPIO_PULL_NONE);
-	// Return mode.
-	return tx_mode;
 }
@@ -0,0 +1,352 @@
+/*
+ * dim.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "dim.h"
+
+#include "adc.h"
+#include "dinfox.h"
+#include "error.h"
+#include "lpuart.h"
+#include "nvm.h"
+#include "rcc_reg.h"
+#include "rs485.h"
+#include "rs485_common.h"
+#include "string.h"
+#include "types.h"
+#include "usart.h"
+#include "version.h"
+
+/*** DIM local global variables ***/
+
+// Node address (or RS485_STATISTICS_BUS) of the RS485 statistics registers.
+static uint8_t dim_rs485_statistics_address = RS485_STATISTICS_BUS;
+
+/*** DIM local functions ***/
+
+/* READ A DIM REGISTER.
+ * @param register_address:		Register address.
+ * @param register_value:		Pointer that will contain the register value.
+ * @param measurements_done:	Pointer to the analog measurements flag (cached data is checked only if the flag is zero, and the flag is set).
+ * @return status:				Function execution status.
+ */
+static ERROR_t _DIM_read_register(uint8_t register_address, int32_t* register_value, uint8_t* measurements_done) {
+	// Local variables.
+	ERROR_t status = SUCCESS;
+	NVM_status_t nvm_status = NVM_SUCCESS;
+	ADC_status_t adc1_status = ADC_SUCCESS;
+	RS485_status_t rs485_status = RS485_SUCCESS;
+	RS485_statistics_t rs485_statistics;
+	uint8_t generic_u8 = 0;
+	int8_t generic_s8 = 0;
+	uint32_t generic_u32 = 0;
+	// Check parameters.
+	if ((register_value == NULL) || (measurements_done == NULL)) {
+		status = ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	// Get data.
+	switch (register_address) {
+	case DINFOX_REGISTER_RS485_ADDRESS:
+		nvm_status = NVM_read_byte(NVM_ADDRESS_RS485_ADDRESS, &generic_u8);
+		NVM_status_check(ERROR_BASE_NVM);
+		(*register_value) = (int32_t) generic_u8;
+		break;
+	case DINFOX_REGISTER_BOARD_ID:
+		(*register_value) = DINFOX_BOARD_ID_DIM;
+		break;
+	case DINFOX_REGISTER_HW_VERSION_MAJOR:
+#if (defined HW1_0) || (defined HW1_1)
+		(*register_value) = 1;
+#endif
+		break;
+	case DINFOX_REGISTER_HW_VERSION_MINOR:
+#ifdef HW1_0
+		(*register_value) = 0;
+#endif
+#ifdef HW1_1
+		(*register_value) = 1;
+#endif
+		break;
+	case DINFOX_REGISTER_SW_VERSION_MAJOR:
+		(*register_value) = GIT_MAJOR_VERSION;
+		break;
+	case DINFOX_REGISTER_SW_VERSION_MINOR:
+		(*register_value) = GIT_MINOR_VERSION;
+		break;
+	case DINFOX_REGISTER_SW_VERSION_COMMIT_INDEX:
+		(*register_value) = GIT_COMMIT_INDEX;
+		break;
+	case DINFOX_REGISTER_SW_VERSION_COMMIT_ID:
+		(*register_value) = GIT_COMMIT_ID;
+		break;
+	case DINFOX_REGISTER_SW_VERSION_DIRTY_FLAG:
+		(*register_value) = GIT_DIRTY_FLAG;
+		break;
+	case DINFOX_REGISTER_RESET:
+		(*register_value) = (int32_t) (((RCC -> CSR) >> 24) & 0xFF);
+		break;
+	case DINFOX_REGISTER_ERROR_STACK:
+		(*register_value) = (int32_t) ERROR_stack_read();
+		break;
+	case DINFOX_REGISTER_VMCU_MV:
+	case DIM_REGISTER_VUSB_MV:
+	case DIM_REGISTER_VRS_MV:
+		// Refresh analog measurements if cached data is stale.
+		if ((*measurements_done) == 0) {
+			adc1_status = ADC1_update_data(0);
+			ADC1_status_check(ERROR_BASE_ADC1);
+			(*measurements_done) = 1;
+		}
+		// Note: indexing only works if registers addresses are ordered in the same way as ADC data indexes.
+		adc1_status = ADC1_get_data((register_address - DINFOX_REGISTER_VMCU_MV), &generic_u32);
+		ADC1_status_check(ERROR_BASE_ADC1);
+		(*register_value) = (int32_t) generic_u32;
+		break;
+	case DINFOX_REGISTER_TMCU_DEGREES:
+		// Refresh analog measurements if cached data is stale.
+		if ((*measurements_done) == 0) {
+			adc1_status = ADC1_update_data(0);
+			ADC1_status_check(ERROR_BASE_ADC1);
+			(*measurements_done) = 1;
+		}
+		// Read temperature.
+		adc1_status = ADC1_get_tmcu(&generic_s8);
+		ADC1_status_check(ERROR_BASE_ADC1);
+		(*register_value) = (int32_t) generic_s8;
+		break;
+	case DIM_REGISTER_RS485_MODE:
+		(*register_value) = (int32_t) RS485_get_mode();
+		break;
+	case DIM_REGISTER_USART_TX_HIGH_WATER_MARK:
+		(*register_value) = (int32_t) USART2_get_tx_high_water_mark();
+		break;
+	case DIM_REGISTER_USART_TX_DROPPED_BYTES:
+		(*register_value) = (int32_t) USART2_get_tx_dropped_bytes();
+		break;
+	case DIM_REGISTER_ADC_DATA_MAX_AGE_S:
+		(*register_value) = (int32_t) ADC1_get_data_max_age();
+		break;
+	case DIM_REGISTER_ADC_DATA_AGE_MS:
+		adc1_status = ADC1_get_data_age(&generic_u32);
+		ADC1_status_check(ERROR_BASE_ADC1);
+		(*register_value) = (int32_t) generic_u32;
+		break;
+	case DIM_REGISTER_RS485_BAUD_RATE:
+		(*register_value) = (int32_t) LPUART1_get_baud_rate();
+		break;
+	case DIM_REGISTER_HOST_BAUD_RATE:
+		(*register_value) = (int32_t) USART2_get_baud_rate();
+		break;
+	case DIM_REGISTER_USART_RX_OVERRUNS:
+		(*register_value) = (int32_t) USART2_get_rx_overruns();
+		break;
+	case DIM_REGISTER_RS485_STATISTICS_ADDRESS:
+		(*register_value) = (int32_t) dim_rs485_statistics_address;
+		break;
+	case DIM_REGISTER_RS485_RX_FRAMES:
+	case DIM_REGISTER_RS485_RX_BYTES:
+	case DIM_REGISTER_RS485_RX_OVERRUNS:
+	case DIM_REGISTER_RS485_RX_TRUNCATED_FRAMES:
+	case DIM_REGISTER_RS485_RX_DROPPED_FRAMES:
+	case DIM_REGISTER_RS485_REPLY_TIMEOUTS:
+	case DIM_REGISTER_RS485_ADDRESS_MISMATCHES:
+	case DIM_REGISTER_RS485_ERROR_REPLIES:
+		rs485_status = RS485_get_statistics(dim_rs485_statistics_address, &rs485_statistics);
+		RS485_status_check(ERROR_BASE_RS485);
+		// Select counter.
+		switch (register_address) {
+		case DIM_REGISTER_RS485_RX_FRAMES:
+			generic_u32 = rs485_statistics.rx_frames;
+			break;
+		case DIM_REGISTER_RS485_RX_BYTES:
+			generic_u32 = rs485_statistics.rx_bytes;
+			break;
+		case DIM_REGISTER_RS485_RX_OVERRUNS:
+			generic_u32 = rs485_statistics.rx_overruns;
+			break;
+		case DIM_REGISTER_RS485_RX_TRUNCATED_FRAMES:
+			generic_u32 = rs485_statistics.rx_truncated_frames;
+			break;
+		case DIM_REGISTER_RS485_RX_DROPPED_FRAMES:
+			generic_u32 = rs485_statistics.rx_dropped_frames;
+			break;
+		case DIM_REGISTER_RS485_REPLY_TIMEOUTS:
+			generic_u32 = rs485_statistics.reply_timeouts;
+			break;
+		case DIM_REGISTER_RS485_ADDRESS_MISMATCHES:
+			generic_u32 = rs485_statistics.address_mismatches;
+			break;
+		case DIM_REGISTER_RS485_ERROR_REPLIES:
+			generic_u32 = rs485_statistics.error_replies;
+			break;
+		default:
+			status = ERROR_REGISTER_ADDRESS;
+			goto errors;
+		}
+		(*register_value) = (int32_t) generic_u32;
+		break;
+	default:
+		status = ERROR_REGISTER_ADDRESS;
+		goto errors;
+	}
+errors:
+	return status;
+}
+
+
+/* GET THE FORMAT USED TO PRINT AND PARSE A REGISTER VALUE.
+ * @param register_address:	Register address.
+ * @return format:			Value format.
+ */
+STRING_format_t DIM_get_register_format(uint8_t register_address) {
+	// Local variables.
+	STRING_format_t format = STRING_FORMAT_DECIMAL;
+	// Check address.
+	switch (register_address) {
+	case DINFOX_REGISTER_RS485_ADDRESS:
+	case DINFOX_REGISTER_BOARD_ID:
+	case DINFOX_REGISTER_SW_VERSION_COMMIT_ID:
+	case DINFOX_REGISTER_RESET:
+	case DINFOX_REGISTER_ERROR_STACK:
+	case DIM_REGISTER_RS485_STATISTICS_ADDRESS:
+		format = STRING_FORMAT_HEXADECIMAL;
+		break;
+	case DINFOX_REGISTER_SW_VERSION_DIRTY_FLAG:
+	case DIM_REGISTER_RS485_MODE:
+		format = STRING_FORMAT_BOOLEAN;
+		break;
+	default:
+		break;
+	}
+	return format;
+}
+
+/* READ A DIM REGISTER.
+ * @param register_address:	Register address.
+ * @param register_value:	Pointer that will contain the register value.
+ * @return status:			Function execution status.
+ */
+ERROR_t DIM_read_register(uint8_t register_address, int32_t* register_value) {
+	// Local variables.
+	uint8_t measurements_done = 0;
+	return _DIM_read_register(register_address, register_value, &measurements_done);
+}
+
+/* READ A LIST OF DIM REGISTERS.
+ * @param register_addresses:	List of registers addresses.
+ * @param number_of_registers:	Number of registers to read.
+ * @param register_values:		Array that will contain the registers values.
+ * @param register_status:		Array that will contain the read status of each register.
+ * @return status:				Function execution status.
+ * Note: analog registers of the list share a single measurement cycle.
+ */
+ERROR_t DIM_read_registers(uint8_t* register_addresses, uint8_t number_of_registers, int32_t* register_values, ERROR_t* register_status) {
+	// Local variables.
+	ERROR_t status = SUCCESS;
+	uint8_t measurements_done = 0;
+	uint8_t idx = 0;
+	// Check parameters.
+	if ((register_addresses == NULL) || (register_values == NULL) || (register_status == NULL)) {
+		status = ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	// Read all registers.
+	for (idx=0 ; idx<number_of_registers ; idx++) {
+		register_status[idx] = _DIM_read_register(register_addresses[idx], &(register_values[idx]), &measurements_done);
+	}
+errors:
+	return status;
+}
+
+/* WRITE A DIM REGISTER.
+ * @param register_address:	Register address.
+ * @param register_value:	Value to write.
+ * @return status:			Function execution status.
+ */
+ERROR_t DIM_write_register(uint8_t register_address, int32_t register_value) {
+	// Local variables.
+	ERROR_t status = SUCCESS;
+	NVM_status_t nvm_status = NVM_SUCCESS;
+	RS485_status_t rs485_status = RS485_SUCCESS;
+	ADC_status_t adc1_status = ADC_SUCCESS;
+	LPUART_status_t lpuart1_status = LPUART_SUCCESS;
+	USART_status_t usart_status = USART_SUCCESS;
+	// Check address.
+	if (register_address >= DIM_REGISTER_LAST) {
+		status = ERROR_REGISTER_ADDRESS;
+		goto errors;
+	}
+	// Write data.
+	switch (register_address) {
+	case DINFOX_REGISTER_RS485_ADDRESS:
+		// Check value.
+		if ((register_value < 0) || (register_value > RS485_ADDRESS_LAST)) {
+			status = ERROR_RS485_ADDRESS;
+			goto errors;
+		}
+		nvm_status = NVM_write_byte(NVM_ADDRESS_RS485_ADDRESS, (uint8_t) register_value);
+		NVM_status_check(ERROR_BASE_NVM);
+		break;
+	case DIM_REGISTER_RS485_MODE:
+		// Update mode.
+		rs485_status = RS485_set_mode((register_value == 0) ? RS485_MODE_DIRECT : RS485_MODE_ADDRESSED);
+		RS485_status_check(ERROR_BASE_RS485);
+		break;
+	case DIM_REGISTER_USART_TX_HIGH_WATER_MARK:
+	case DIM_REGISTER_USART_TX_DROPPED_BYTES:
+	case DIM_REGISTER_USART_RX_OVERRUNS:
+		// Any write resets all statistics.
+		USART2_reset_statistics();
+		break;
+	case DIM_REGISTER_RS485_STATISTICS_ADDRESS:
+		// Check value.
+		if (((register_value < 0) || (register_value > RS485_ADDRESS_LAST)) && (register_value != RS485_STATISTICS_BUS)) {
+			status = ERROR_RS485_ADDRESS;
+			goto errors;
+		}
+		dim_rs485_statistics_address = (uint8_t) register_value;
+		break;
+	case DIM_REGISTER_RS485_RX_FRAMES:
+	case DIM_REGISTER_RS485_RX_BYTES:
+	case DIM_REGISTER_RS485_RX_OVERRUNS:
+	case DIM_REGISTER_RS485_RX_TRUNCATED_FRAMES:
+	case DIM_REGISTER_RS485_RX_DROPPED_FRAMES:
+	case DIM_REGISTER_RS485_REPLY_TIMEOUTS:
+	case DIM_REGISTER_RS485_ADDRESS_MISMATCHES:
+	case DIM_REGISTER_RS485_ERROR_REPLIES:
+		// Any write resets bus-wide and per node statistics.
+		RS485_reset_statistics();
+		break;
+	case DIM_REGISTER_ADC_DATA_MAX_AGE_S:
+		// Check value.
+		if (register_value < 0) {
+			status = ERROR_BASE_ADC1 + ADC_ERROR_DATA_MAX_AGE;
+			goto errors;
+		}
+		adc1_status = ADC1_set_data_max_age((uint32_t) register_value);
+		ADC1_status_check(ERROR_BASE_ADC1);
+		break;
+	case DIM_REGISTER_RS485_BAUD_RATE:
+		// Apply new baud rate (value is checked by the driver).
+		lpuart1_status = LPUART1_set_baud_rate((uint32_t) register_value);
+		LPUART1_status_check(ERROR_BASE_LPUART1);
+		// Save it in NVM.
+		nvm_status = NVM_write_word(NVM_ADDRESS_RS485_BAUD_RATE, (uint32_t) register_value);
+		NVM_status_check(ERROR_BASE_NVM);
+		break;
+	case DIM_REGISTER_HOST_BAUD_RATE:
+		// Switch is applied once the reply has been sent, and saved in NVM only when confirmed by the host (see AT manager).
+		usart_status = USART2_set_baud_rate((uint32_t) register_value);
+		USART_status_check(ERROR_BASE_USART);
+		break;
+	default:
+		status = ERROR_REGISTER_READ_ONLY;
+		goto errors;
+	}
+errors:
+	return status;
+}
@@ -0,0 +1,397 @@
+/*
+ * node.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "node.h"
+
+#include "dinfox.h"
+#include "nvm.h"
+#include "rs485.h"
+#include "rs485_common.h"
+#include "rtc.h"
+#include "types.h"
+
+/*** NODE local macros ***/
+
+#define NODE_NVM_ENTRY_SIZE_BYTES	4 // Address, board ID and reply time (16 bits).
+#define NODE_RESCAN_WINDOW_SIZE		8
+#define NODE_RESCAN_MISS_COUNT_MAX	3 // Known nodes are removed after this number of consecutive missed probes.
+
+/*** NODE local structures ***/
+
+typedef struct {
+	NODE_t list[NODE_LIST_SIZE];
+	uint8_t count;
+	RS485_address_t rescan_address;
+	uint8_t nvm_update_required;
+	// Resumable range scan.
+	RS485_node_t scan_list[NODE_LIST_SIZE];
+	uint8_t scan_count;
+	uint8_t scan_running;
+	RS485_address_t scan_address; // Next address to probe.
+	RS485_address_t scan_first_address;
+	RS485_address_t scan_last_address;
+} NODE_context_t;
+
+/*** NODE local global variables ***/
+
+static NODE_context_t node_ctx;
+
+/*** NODE local functions ***/
+
+/* WRITE A BYTE IN NVM ONLY IF ITS VALUE CHANGED.
+ * @param address:	NVM address.
+ * @param data:		Byte to write.
+ * @return status:	Function execution status.
+ */
+static NVM_status_t _NODE_nvm_update_byte(NVM_address_t address, uint8_t data) {
+	// Local variables.
+	NVM_status_t status = NVM_SUCCESS;
+	uint8_t nvm_data = 0;
+	// Read current value to limit EEPROM wear.
+	status = NVM_read_byte(address, &nvm_data);
+	if (status != NVM_SUCCESS) goto errors;
+	if (nvm_data != data) {
+		status = NVM_write_byte(address, data);
+	}
+errors:
+	return status;
+}
+
+/* SAVE NODES TABLE IN NVM.
+ * @param:			None.
+ * @return status:	Function execution status.
+ */
+static NODE_status_t _NODE_save(void) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	NVM_status_t nvm_status = NVM_SUCCESS;
+	NVM_address_t nvm_address = NVM_ADDRESS_NODE_TABLE;
+	uint8_t idx = 0;
+	// Check flag.
+	if (node_ctx.nvm_update_required == 0) goto errors;
+	// Save nodes.
+	for (idx=0 ; idx<node_ctx.count ; idx++) {
+		nvm_status = _NODE_nvm_update_byte(nvm_address++, node_ctx.list[idx].node.address);
+		NVM_status_check(NODE_ERROR_BASE_NVM);
+		nvm_status = _NODE_nvm_update_byte(nvm_address++, node_ctx.list[idx].node.board_id);
+		NVM_status_check(NODE_ERROR_BASE_NVM);
+		nvm_status = _NODE_nvm_update_byte(nvm_address++, (uint8_t) (node_ctx.list[idx].node.reply_time_ms >> 8));
+		NVM_status_check(NODE_ERROR_BASE_NVM);
+		nvm_status = _NODE_nvm_update_byte(nvm_address++, (uint8_t) (node_ctx.list[idx].node.reply_time_ms >> 0));
+		NVM_status_check(NODE_ERROR_BASE_NVM);
+	}
+	// Save count.
+	nvm_status = _NODE_nvm_update_byte(NVM_ADDRESS_NODE_COUNT, node_ctx.count);
+	NVM_status_check(NODE_ERROR_BASE_NVM);
+	// Clear flag.
+	node_ctx.nvm_update_required = 0;
+errors:
+	return status;
+}
+
+/* REMOVE A NODE FROM TABLE.
+ * @param node_index:	Index of the node to remove.
+ * @return:				None.
+ */
+static void _NODE_remove(uint8_t node_index) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Shift next nodes.
+	for (idx=node_index ; idx<(node_ctx.count - 1) ; idx++) {
+		node_ctx.list[idx] = node_ctx.list[idx + 1];
+	}
+	node_ctx.count--;
+	node_ctx.nvm_update_required = 1;
+}
+
+/* UPDATE OR INSERT A NODE WHICH HAS JUST REPLIED.
+ * @param node:	Pointer to the node data returned by the RS485 layer.
+ * @return:		None.
+ * Note: the table is kept sorted by address.
+ */
+static void _NODE_update(RS485_node_t* node) {
+	// Local variables.
+	uint8_t idx = 0;
+	uint8_t insert_idx = 0;
+	// Search node.
+	for (idx=0 ; idx<node_ctx.count ; idx++) {
+		if (node_ctx.list[idx].node.address == (node -> address)) break;
+		if (node_ctx.list[idx].node.address < (node -> address)) insert_idx = (idx + 1);
+	}
+	if (idx >= node_ctx.count) {
+		// New node.
+		if (node_ctx.count >= NODE_LIST_SIZE) goto errors;
+		for (idx=node_ctx.count ; idx>insert_idx ; idx--) {
+			node_ctx.list[idx] = node_ctx.list[idx - 1];
+		}
+		idx = insert_idx;
+		node_ctx.count++;
+		node_ctx.list[idx].node.address = (node -> address);
+		node_ctx.list[idx].node.reply_time_ms = (node -> reply_time_ms);
+		node_ctx.nvm_update_required = 1;
+	}
+	// Update board ID (reply time is only saved on table changes).
+	if (node_ctx.list[idx].node.board_id != (node -> board_id)) {
+		node_ctx.list[idx].node.board_id = (node -> board_id);
+		node_ctx.nvm_update_required = 1;
+	}
+	node_ctx.list[idx].node.reply_time_ms = (node -> reply_time_ms);
+	node_ctx.list[idx].seen_flag = 1;
+	node_ctx.list[idx].last_seen_ms = RTC_get_time_ms();
+	node_ctx.list[idx].miss_count = 0;
+errors:
+	return;
+}
+
+/* CHECK IF A NODE IS IN THE TABLE.
+ * @param address:	Node address.
+ * @return:			1 if the address is known, 0 otherwise.
+ */
+static uint8_t _NODE_is_known(RS485_address_t address) {
+	// Local variables.
+	uint8_t idx = 0;
+	for (idx=0 ; idx<node_ctx.count ; idx++) {
+		if (node_ctx.list[idx].node.address == address) return 1;
+	}
+	return 0;
+}
+
+/*** NODE functions ***/
+
+/* INIT NODES TABLE FROM NVM.
+ * @param:			None.
+ * @return status:	Function execution status.
+ */
+NODE_status_t NODE_init(void) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	NVM_status_t nvm_status = NVM_SUCCESS;
+	NVM_address_t nvm_address = NVM_ADDRESS_NODE_TABLE;
+	uint8_t nvm_count = 0;
+	uint8_t reply_time_msb = 0;
+	uint8_t reply_time_lsb = 0;
+	uint8_t idx = 0;
+	// Init context.
+	node_ctx.count = 0;
+	node_ctx.rescan_address = 0;
+	node_ctx.nvm_update_required = 0;
+	node_ctx.scan_running = 0;
+	// Read count.
+	nvm_status = NVM_read_byte(NVM_ADDRESS_NODE_COUNT, &nvm_count);
+	NVM_status_check(NODE_ERROR_BASE_NVM);
+	if (nvm_count > NODE_LIST_SIZE) goto errors;
+	// Read nodes.
+	for (idx=0 ; idx<nvm_count ; idx++) {
+		nvm_status = NVM_read_byte(nvm_address++, &node_ctx.list[idx].node.address);
+		NVM_status_check(NODE_ERROR_BASE_NVM);
+		nvm_status = NVM_read_byte(nvm_address++, &node_ctx.list[idx].node.board_id);
+		NVM_status_check(NODE_ERROR_BASE_NVM);
+		nvm_status = NVM_read_byte(nvm_address++, &reply_time_msb);
+		NVM_status_check(NODE_ERROR_BASE_NVM);
+		nvm_status = NVM_read_byte(nvm_address++, &reply_time_lsb);
+		NVM_status_check(NODE_ERROR_BASE_NVM);
+		// Stop on invalid entry.
+		if (node_ctx.list[idx].node.address > RS485_ADDRESS_LAST) break;
+		node_ctx.list[idx].node.reply_time_ms = (uint16_t) ((reply_time_msb << 8) | reply_time_lsb);
+		node_ctx.list[idx].seen_flag = 0;
+		node_ctx.list[idx].last_seen_ms = 0;
+		node_ctx.list[idx].miss_count = 0;
+		node_ctx.count++;
+	}
+errors:
+	return status;
+}
+
+/* SCAN A RANGE OF ADDRESSES AND UPDATE NODES TABLE.
+ * @param first_address:	First address to probe.
+ * @param last_address:		Last address to probe (included).
+ * @return status:			Function execution status.
+ * Note: blocking version of the resumable scan.
+ */
+NODE_status_t NODE_scan(RS485_address_t first_address, RS485_address_t last_address) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	// Start scan.
+	status = NODE_start_scan(first_address, last_address);
+	if (status != NODE_SUCCESS) goto errors;
+	// Probe all addresses.
+	while (node_ctx.scan_running != 0) {
+		status = NODE_scan_step();
+		if (status != NODE_SUCCESS) goto errors;
+	}
+errors:
+	return status;
+}
+
+/* START A RESUMABLE SCAN OF A RANGE OF ADDRESSES.
+ * @param first_address:	First address to probe.
+ * @param last_address:		Last address to probe (included).
+ * @return status:			Function execution status.
+ * Note: addresses are then probed one by one with the NODE_scan_step() function, the table is updated at the end of the range.
+ */
+NODE_status_t NODE_start_scan(RS485_address_t first_address, RS485_address_t last_address) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	RS485_status_t rs485_status = RS485_SUCCESS;
+	// Check parameters.
+	if ((first_address > last_address) || (last_address > RS485_ADDRESS_LAST)) {
+		status = (NODE_ERROR_BASE_RS485 + RS485_ERROR_ADDRESS_RANGE);
+		goto errors;
+	}
+	// Set mode.
+	rs485_status = RS485_set_mode(RS485_MODE_ADDRESSED);
+	RS485_status_check(NODE_ERROR_BASE_RS485);
+	// Init scan context.
+	node_ctx.scan_count = 0;
+	node_ctx.scan_address = first_address;
+	node_ctx.scan_first_address = first_address;
+	node_ctx.scan_last_address = last_address;
+	node_ctx.scan_running = 1;
+errors:
+	return status;
+}
+
+/* PROBE NEXT ADDRESS OF THE RUNNING SCAN.
+ * @param:			None.
+ * @return status:	Function execution status.
+ * Note: the scan is aborted on error.
+ */
+NODE_status_t NODE_scan_step(void) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	RS485_status_t rs485_status = RS485_SUCCESS;
+	RS485_node_t node;
+	uint8_t number_of_nodes_found = 0;
+	uint8_t idx = 0;
+	// Check state.
+	if (node_ctx.scan_running == 0) goto errors;
+	// Probe current address.
+	rs485_status = RS485_scan_nodes(node_ctx.scan_address, node_ctx.scan_address, &node, 1, &number_of_nodes_found);
+	if (rs485_status != RS485_SUCCESS) {
+		node_ctx.scan_running = 0;
+		status = (NODE_ERROR_BASE_RS485 + rs485_status);
+		goto errors;
+	}
+	if ((number_of_nodes_found != 0) && (node_ctx.scan_count < NODE_LIST_SIZE)) {
+		node_ctx.scan_list[node_ctx.scan_count] = node;
+		node_ctx.scan_count++;
+	}
+	// Go to next address.
+	if (node_ctx.scan_address < node_ctx.scan_last_address) {
+		node_ctx.scan_address++;
+		goto errors;
+	}
+	// End of range: remove previous nodes of the range.
+	node_ctx.scan_running = 0;
+	idx = 0;
+	while (idx < node_ctx.count) {
+		if ((node_ctx.list[idx].node.address >= node_ctx.scan_first_address) && (node_ctx.list[idx].node.address <= node_ctx.scan_last_address)) {
+			_NODE_remove(idx);
+		}
+		else {
+			idx++;
+		}
+	}
+	// Add nodes found.
+	for (idx=0 ; idx<node_ctx.scan_count ; idx++) {
+		_NODE_update(&(node_ctx.scan_list[idx]));
+	}
+	// Save table.
+	node_ctx.nvm_update_required = 1;
+	status = _NODE_save();
+errors:
+	return status;
+}
+
+/* GET SCAN STATUS.
+ * @param:	None.
+ * @return:	1 if a resumable scan is running, 0 otherwise.
+ */
+uint8_t NODE_is_scan_running(void) {
+	return node_ctx.scan_running;
+}
+
+/* INCREMENTAL RESCAN: PROBE KNOWN NODES AND A ROLLING WINDOW OF UNKNOWN ADDRESSES.
+ * @param:			None.
+ * @return status:	Function execution status.
+ */
+NODE_status_t NODE_rescan(void) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	RS485_status_t rs485_status = RS485_SUCCESS;
+	RS485_node_t node;
+	RS485_address_t address = 0;
+	uint8_t number_of_nodes_found = 0;
+	uint8_t idx = 0;
+	// Set mode.
+	rs485_status = RS485_set_mode(RS485_MODE_ADDRESSED);
+	RS485_status_check(NODE_ERROR_BASE_RS485);
+	// Probe known nodes (a single missed reply does not remove the node).
+	idx = 0;
+	while (idx < node_ctx.count) {
+		address = node_ctx.list[idx].node.address;
+		rs485_status = RS485_scan_nodes(address, address, &node, 1, &number_of_nodes_found);
+		RS485_status_check(NODE_ERROR_BASE_RS485);
+		if (number_of_nodes_found != 0) {
+			_NODE_update(&node);
+			idx++;
+			continue;
+		}
+		node_ctx.list[idx].miss_count++;
+		if (node_ctx.list[idx].miss_count >= NODE_RESCAN_MISS_COUNT_MAX) {
+			_NODE_remove(idx);
+		}
+		else {
+			idx++;
+		}
+	}
+	// Probe rolling window of unknown addresses.
+	for (idx=0 ; idx<NODE_RESCAN_WINDOW_SIZE ; idx++) {
+		address = node_ctx.rescan_address;
+		node_ctx.rescan_address = (node_ctx.rescan_address + 1) & RS485_ADDRESS_MASK;
+		if (_NODE_is_known(address) != 0) continue;
+		rs485_status = RS485_scan_nodes(address, address, &node, 1, &number_of_nodes_found);
+		RS485_status_check(NODE_ERROR_BASE_RS485);
+		if (number_of_nodes_found != 0) {
+			_NODE_update(&node);
+		}
+	}
+	// Save table if needed.
+	status = _NODE_save();
+errors:
+	return status;
+}
+
+/* GET NUMBER OF NODES IN TABLE.
+ * @param:	None.
+ * @return:	Number of known nodes.
+ */
+uint8_t NODE_get_count(void) {
+	return node_ctx.count;
+}
+
+/* GET A NODE FROM TABLE.
+ * @param node_index:	Index of the node in table.
+ * @param node:			Pointer that will contain the node data.
+ * @return status:		Function execution status.
+ */
+NODE_status_t NODE_get(uint8_t node_index, NODE_t* node) {
+	// Local variables.
+	NODE_status_t status = NODE_SUCCESS;
+	// Check parameters.
+	if (node == NULL) {
+		status = NODE_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	if (node_index >= node_ctx.count) {
+		status = NODE_ERROR_INDEX;
+		goto errors;
+	}
+	(*node) = node_ctx.list[node_index];
+errors:
+	return status;
+}
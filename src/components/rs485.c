@@ -9,30 +9,45 @@
 
 #include "at.h"
 #include "dinfox.h"
+#include "event.h"
 #include "iwdg.h"
 #include "lptim.h"
 #include "lpuart.h"
+#include "pwr.h"
 #include "rs485_common.h"
 #include "string.h"
 
 /*** RS485 local macros ***/
 
 #define RS485_BUFFER_SIZE_BYTES			80
-#define RS485_REPLY_BUFFER_DEPTH		64
+#define RS485_RX_RING_SIZE_BYTES		512 // Must be a power of 2.
 
-#define RS485_REPLY_PARSING_DELAY_MS	10
 #define RS485_REPLY_TIMEOUT_MS			100
 #define RS485_SEQUENCE_TIMEOUT_MS		1000
+#define RS485_TX_TIMEOUT_COUNT			100000
+
+#define RS485_SCAN_TURNAROUND_MS			20
+#define RS485_SCAN_REPLY_SIZE_MAX_BYTES		16
+
+#define RS485_STATISTICS_NODES_MAX		16
 
 #define RS485_REPLY_OK					"OK"
 #define RS485_REPLY_ERROR				"ERROR"
 
 /*** RS485 local structures ***/
 
+typedef enum {
+	RS485_REPLY_EVENT_TIMEOUT = 0,
+	RS485_REPLY_EVENT_ADDRESS_MISMATCH,
+	RS485_REPLY_EVENT_ERROR,
+	RS485_REPLY_EVENT_LAST
+} RS485_reply_event_t;
+
 typedef enum {
 	RS485_REPLY_TYPE_RAW = 0,
 	RS485_REPLY_TYPE_OK,
 	RS485_REPLY_TYPE_VALUE,
+	RS485_REPLY_TYPE_ANY,
 	RS485_REPLY_TYPE_LAST
 } RS485_reply_type_t;
 
@@ -45,24 +60,40 @@ typedef struct {
 typedef struct {
 	int32_t value; // For value type.
 	uint8_t error_flag;
+	uint32_t reply_time_ms; // Time between end of transmission and reception of the parsed reply.
 } RS485_reply_output_t;
 
 typedef struct {
-	volatile char_t buffer[RS485_BUFFER_SIZE_BYTES];
-	volatile uint8_t size;
-	volatile uint8_t line_end_flag;
-	PARSER_context_t parser;
-} RS485_reply_buffer_t;
+	uint8_t address;
+	uint32_t rx_frames;
+	uint32_t rx_bytes;
+	uint32_t rx_truncated_frames;
+	uint32_t reply_timeouts;
+	uint32_t address_mismatches;
+	uint32_t error_replies;
+} RS485_node_statistics_t;
 
 typedef struct {
 	RS485_mode_t mode;
 	// Command buffer.
 	char_t command[RS485_BUFFER_SIZE_BYTES];
 	uint8_t expected_slave_address;
-	// Response buffers.
-	RS485_reply_buffer_t reply[RS485_REPLY_BUFFER_DEPTH];
-	uint8_t reply_write_idx;
-	uint8_t reply_read_idx;
+	// Reception ring: frames are stored as a length byte followed by data (written by LPUART interrupt only).
+	volatile uint8_t rx_ring[RS485_RX_RING_SIZE_BYTES];
+	volatile uint32_t rx_write_idx; // Committed frames end (producer).
+	volatile uint32_t rx_read_idx; // Next frame to read (consumer).
+	volatile uint32_t rx_frame_start_idx; // Length byte index of the frame being received.
+	volatile uint8_t rx_frame_size;
+	volatile uint8_t rx_frame_overflow;
+	volatile uint8_t rx_frame_truncated;
+	// Traffic statistics (bus-wide and per node, node slots are allocated on first traffic).
+	RS485_statistics_t statistics;
+	RS485_node_statistics_t node_statistics[RS485_STATISTICS_NODES_MAX];
+	volatile uint8_t node_statistics_count;
+	// Current reply (linear copy of the last frame read from ring).
+	char_t reply[RS485_BUFFER_SIZE_BYTES];
+	uint8_t reply_size;
+	PARSER_context_t parser;
 } RS485_context_t;
 
 /*** RS485 local global variables ***/
@@ -109,36 +140,137 @@ errors:
 	return status;
 }
 
-/* RESET RS485 REPLY BUFFER.
- * @param reply_index:	Reply index to reset.
- * @return:				None.
+/* RESET FRAME BEING RECEIVED.
+ * @param:	None.
+ * @return:	None.
+ * Note: must be called while the receiver is disabled.
  */
-static void _RS485_reset_reply(uint8_t reply_index) {
-	// Flush buffer.
-	rs485_ctx.reply[reply_index].size = 0;
-	// Reset flag.
-	rs485_ctx.reply[reply_index].line_end_flag = 0;
-	// Reset parser.
-	rs485_ctx.reply[reply_index].parser.buffer = (char_t*) rs485_ctx.reply[reply_index].buffer;
-	rs485_ctx.reply[reply_index].parser.buffer_size = 0;
-	rs485_ctx.reply[reply_index].parser.separator_idx = 0;
-	rs485_ctx.reply[reply_index].parser.start_idx = 0;
+static void _RS485_reset_rx_frame(void) {
+	// Local variables.
+	uint32_t primask = 0;
+	// Bytes already received can still be flushed by the DMA interrupt (previous PRIMASK is restored).
+	__asm volatile ("mrs %0, primask" : "=r" (primask));
+	__asm volatile ("cpsid i");
+	rs485_ctx.rx_frame_start_idx = rs485_ctx.rx_write_idx;
+	rs485_ctx.rx_frame_size = 0;
+	rs485_ctx.rx_frame_overflow = 0;
+	rs485_ctx.rx_frame_truncated = 0;
+	__asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+}
+
+/* GET STATISTICS SLOT OF A NODE.
+ * @param address:	Node address.
+ * @param allocate:	Allocate a new slot if the address is not in the table when non zero.
+ * @return:			Pointer to the node statistics, NULL if the address is not found or if the table is full.
+ * Note: this function must not be interrupted by the LPUART interrupt which allocates slots on frame reception.
+ */
+static RS485_node_statistics_t* _RS485_get_node_statistics(uint8_t address, uint8_t allocate) {
+	// Local variables.
+	RS485_node_statistics_t* node_statistics = NULL;
+	uint8_t idx = 0;
+	// Search address in table.
+	for (idx=0 ; idx<rs485_ctx.node_statistics_count ; idx++) {
+		if (rs485_ctx.node_statistics[idx].address == address) {
+			node_statistics = &(rs485_ctx.node_statistics[idx]);
+			goto errors;
+		}
+	}
+	// Allocate new slot.
+	if ((allocate != 0) && (rs485_ctx.node_statistics_count < RS485_STATISTICS_NODES_MAX)) {
+		node_statistics = &(rs485_ctx.node_statistics[rs485_ctx.node_statistics_count]);
+		(node_statistics -> address) = address;
+		(node_statistics -> rx_frames) = 0;
+		(node_statistics -> rx_bytes) = 0;
+		(node_statistics -> rx_truncated_frames) = 0;
+		(node_statistics -> reply_timeouts) = 0;
+		(node_statistics -> address_mismatches) = 0;
+		(node_statistics -> error_replies) = 0;
+		rs485_ctx.node_statistics_count++;
+	}
+errors:
+	return node_statistics;
+}
+
+/* COUNT A REPLY EVENT FOR THE EXPECTED SLAVE.
+ * @param event:	Event to count.
+ * @return:			None.
+ */
+static void _RS485_count_reply_event(RS485_reply_event_t event) {
+	// Local variables.
+	RS485_node_statistics_t* node_statistics = NULL;
+	uint32_t primask = 0;
+	// Node slot allocation is shared with the LPUART interrupt (previous PRIMASK is restored).
+	__asm volatile ("mrs %0, primask" : "=r" (primask));
+	__asm volatile ("cpsid i");
+	// Per node counters are relevant in addressed mode only, and silent addresses (scan) do not get a slot.
+	if (rs485_ctx.mode == RS485_MODE_ADDRESSED) {
+		node_statistics = _RS485_get_node_statistics(rs485_ctx.expected_slave_address, 0);
+	}
+	switch (event) {
+	case RS485_REPLY_EVENT_TIMEOUT:
+		rs485_ctx.statistics.reply_timeouts++;
+		if (node_statistics != NULL) (node_statistics -> reply_timeouts)++;
+		break;
+	case RS485_REPLY_EVENT_ADDRESS_MISMATCH:
+		rs485_ctx.statistics.address_mismatches++;
+		if (node_statistics != NULL) (node_statistics -> address_mismatches)++;
+		break;
+	case RS485_REPLY_EVENT_ERROR:
+		rs485_ctx.statistics.error_replies++;
+		if (node_statistics != NULL) (node_statistics -> error_replies)++;
+		break;
+	default:
+		break;
+	}
+	__asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
 }
 
-/* RESET RS485 PARSER.
+/* FLUSH RS485 RECEIVED FRAMES.
  * @param:	None.
  * @return:	None.
  */
 static void _RS485_reset_replies(void) {
-	// Local variabless.
-	uint8_t rep_idx = 0;
-	// Reset replys buffers.
-	for (rep_idx=0 ; rep_idx<RS485_REPLY_BUFFER_DEPTH ; rep_idx++) {
-		_RS485_reset_reply(rep_idx);
+	// Discard all committed frames (consumer side only).
+	rs485_ctx.rx_read_idx = rs485_ctx.rx_write_idx;
+}
+
+/* READ NEXT RECEIVED FRAME.
+ * @param:	None.
+ * @return:	1 if a frame has been copied in the reply buffer, 0 if the ring is empty.
+ */
+static uint8_t _RS485_read_reply(void) {
+	// Local variables.
+	uint32_t read_idx = rs485_ctx.rx_read_idx;
+	uint8_t idx = 0;
+	// Check ring.
+	if (read_idx == rs485_ctx.rx_write_idx) return 0;
+	// Read length and copy frame.
+	rs485_ctx.reply_size = rs485_ctx.rx_ring[read_idx];
+	read_idx = (read_idx + 1) & (RS485_RX_RING_SIZE_BYTES - 1);
+	for (idx=0 ; idx<rs485_ctx.reply_size ; idx++) {
+		rs485_ctx.reply[idx] = (char_t) rs485_ctx.rx_ring[read_idx];
+		read_idx = (read_idx + 1) & (RS485_RX_RING_SIZE_BYTES - 1);
 	}
-	// Reset index and count.
-	rs485_ctx.reply_write_idx = 0;
-	rs485_ctx.reply_read_idx = 0;
+	rs485_ctx.reply[rs485_ctx.reply_size] = STRING_CHAR_NULL;
+	// Release frame.
+	rs485_ctx.rx_read_idx = read_idx;
+	// Reset parser.
+	rs485_ctx.parser.buffer = (char_t*) rs485_ctx.reply;
+	rs485_ctx.parser.buffer_size = rs485_ctx.reply_size;
+	rs485_ctx.parser.separator_idx = 0;
+	rs485_ctx.parser.start_idx = 0;
+	return 1;
+}
+
+/* COMPUTE NEXT REPLY TIMER DURATION.
+ * @param reply_timeout_ms:	Reply timeout.
+ * @param sequence_time_ms:	Time elapsed since the beginning of the sequence.
+ * @return:					Timer duration in ms (minimum of the reply and remaining sequence times).
+ */
+static uint32_t _RS485_get_timer_duration(uint32_t reply_timeout_ms, uint32_t sequence_time_ms) {
+	// Local variables.
+	uint32_t sequence_remaining_ms = (sequence_time_ms < RS485_SEQUENCE_TIMEOUT_MS) ? (RS485_SEQUENCE_TIMEOUT_MS - sequence_time_ms) : 1;
+	return (reply_timeout_ms < sequence_remaining_ms) ? reply_timeout_ms : sequence_remaining_ms;
 }
 
 /* WAIT FOR RECEIVING A VALUE.
@@ -151,9 +283,10 @@ static RS485_status_t _RS485_wait_reply(RS485_reply_input_t* reply_in_ptr, RS485
 	RS485_status_t status = RS485_SUCCESS;
 	PARSER_status_t parser_status = PARSER_SUCCESS;
 	LPTIM_status_t lptim1_status = LPTIM_SUCCESS;
-	uint8_t idx = 0;
-	uint32_t reply_time_ms = 0;
+	uint32_t timer_duration_ms = 0;
 	uint32_t sequence_time_ms = 0;
+	uint32_t loop_count = 0;
+	uint8_t tx_running = 0;
 	uint8_t reply_count = 0;
 	// Check parameters.
 	if ((reply_in_ptr == NULL) || (reply_out_ptr == NULL)) {
@@ -163,92 +296,124 @@ static RS485_status_t _RS485_wait_reply(RS485_reply_input_t* reply_in_ptr, RS485
 	// Reset output data.
 	(reply_out_ptr -> value) = 0;
 	(reply_out_ptr -> error_flag) = 0;
+	(reply_out_ptr -> reply_time_ms) = 0;
+	// Reply timeout starts when the command has been fully sent.
+	// Interrupts are masked while checking the status so that the TC interrupt can not occur just before WFI.
+	while (1) {
+		__asm volatile ("cpsid i");
+		tx_running = LPUART1_is_tx_running();
+		if (tx_running != 0) {
+			PWR_enter_sleep_mode();
+		}
+		__asm volatile ("cpsie i");
+		if (tx_running == 0) break;
+		// Wait for TC interrupt or timeout.
+		loop_count++;
+		if (loop_count > RS485_TX_TIMEOUT_COUNT) {
+			status = RS485_ERROR_TX_TIMEOUT;
+			goto errors;
+		}
+	}
+	// Start timer.
+	timer_duration_ms = _RS485_get_timer_duration(reply_in_ptr -> timeout_ms, sequence_time_ms);
+	lptim1_status = LPTIM1_start_timer(timer_duration_ms);
+	LPTIM1_status_check(RS485_ERROR_BASE_LPTIM);
 	// Main reception loop.
 	while (1) {
-		// Delay.
-		lptim1_status = LPTIM1_delay_milliseconds(RS485_REPLY_PARSING_DELAY_MS, 0);
-		LPTIM1_status_check(RS485_ERROR_BASE_LPTIM);
-		reply_time_ms += RS485_REPLY_PARSING_DELAY_MS;
-		sequence_time_ms += RS485_REPLY_PARSING_DELAY_MS;
-		// Loop on all replys.
-		for (idx=0 ; idx<RS485_REPLY_BUFFER_DEPTH ; idx++) {
-			// Check line end flag.
-			if (rs485_ctx.reply[idx].line_end_flag != 0) {
-				// Increment parsing count.
-				reply_count++;
-				// Reset time and flag.
-				reply_time_ms = 0;
-				rs485_ctx.reply[idx].line_end_flag = 0;
-				// Check mode.
-				if (rs485_ctx.mode == RS485_MODE_ADDRESSED) {
-					// Check source address.
-					if (rs485_ctx.reply[idx].buffer[RS485_FRAME_FIELD_INDEX_SOURCE_ADDRESS] != rs485_ctx.expected_slave_address) {
-						status = RS485_ERROR_SOURCE_ADDRESS_MISMATCH;
-						continue;
-					}
-					// Skip source address before parsing.
-					rs485_ctx.reply[idx].parser.buffer = (char_t*) &(rs485_ctx.reply[idx].buffer[RS485_FRAME_FIELD_INDEX_DATA]);
-					rs485_ctx.reply[idx].parser.buffer_size = (rs485_ctx.reply[idx].size > 0) ? (rs485_ctx.reply[idx].size - RS485_FRAME_FIELD_INDEX_DATA) : 0;
-				}
-				else {
-					// Update buffer length.
-					rs485_ctx.reply[idx].parser.buffer_size = rs485_ctx.reply[idx].size;
-				}
-				// Parse reply.
-				switch (reply_in_ptr -> type) {
-				case RS485_REPLY_TYPE_RAW:
-					// Do not parse.
-					parser_status = PARSER_SUCCESS;
-					break;
-				case RS485_REPLY_TYPE_OK:
-					// Compare to reference string.
-					parser_status = PARSER_compare(&rs485_ctx.reply[idx].parser, PARSER_MODE_COMMAND, RS485_REPLY_OK);
-					break;
-				case RS485_REPLY_TYPE_VALUE:
-					// Parse value.
-					parser_status = PARSER_get_parameter(&rs485_ctx.reply[idx].parser, (reply_in_ptr -> format), STRING_CHAR_NULL, &(reply_out_ptr -> value));
-					break;
-				default:
-					status = RS485_ERROR_REPLY_TYPE;
-					goto errors;
-				}
-				// Check status.
-				if (parser_status == PARSER_SUCCESS) {
-					// Update status.
-					status = RS485_SUCCESS;
-					// In raw mode, let the function run until one of the 2 timeouts is reached.
-					// In other modes, exit as soon as the value was successfully parsed.
-					if ((reply_in_ptr -> type) != RS485_REPLY_TYPE_RAW) goto errors; // Not an error but to exit loop.
-				}
-				else {
-					status = (RS485_ERROR_BASE_PARSER + parser_status);
-				}
-				// Check error.
-				parser_status = PARSER_compare(&rs485_ctx.reply[idx].parser, PARSER_MODE_COMMAND, RS485_REPLY_ERROR);
-				if (parser_status == PARSER_SUCCESS) {
-					// Update output data.
-					(reply_out_ptr -> error_flag) = 1;
-					// Exit.
-					status = RS485_SUCCESS;
-					goto errors;
+		// Wait for a reply or timer expiration (any interrupt wakes the core up).
+		// Interrupts are masked while checking the conditions so that a reception or timer interrupt can not be missed before WFI.
+		__asm volatile ("cpsid i");
+		if ((rs485_ctx.rx_read_idx == rs485_ctx.rx_write_idx) && (LPTIM1_get_timer_flag() == 0)) {
+			PWR_enter_sleep_mode();
+		}
+		__asm volatile ("cpsie i");
+		// Process all received replies in order.
+		while (_RS485_read_reply() != 0) {
+			// Increment parsing count.
+			reply_count++;
+			// Restart reply timer.
+			sequence_time_ms += LPTIM1_get_timer_elapsed_ms();
+			(reply_out_ptr -> reply_time_ms) = sequence_time_ms;
+			timer_duration_ms = _RS485_get_timer_duration(reply_in_ptr -> timeout_ms, sequence_time_ms);
+			lptim1_status = LPTIM1_start_timer(timer_duration_ms);
+			LPTIM1_status_check(RS485_ERROR_BASE_LPTIM);
+			// Check mode.
+			if (rs485_ctx.mode == RS485_MODE_ADDRESSED) {
+				// Check source address.
+				if ((rs485_ctx.reply_size < RS485_FRAME_FIELD_INDEX_DATA) || (rs485_ctx.reply[RS485_FRAME_FIELD_INDEX_SOURCE_ADDRESS] != rs485_ctx.expected_slave_address)) {
+					status = RS485_ERROR_SOURCE_ADDRESS_MISMATCH;
+					_RS485_count_reply_event(RS485_REPLY_EVENT_ADDRESS_MISMATCH);
+					continue;
 				}
+				// Skip source address before parsing.
+				rs485_ctx.parser.buffer = &(rs485_ctx.reply[RS485_FRAME_FIELD_INDEX_DATA]);
+				rs485_ctx.parser.buffer_size = (rs485_ctx.reply_size - RS485_FRAME_FIELD_INDEX_DATA);
+			}
+			// Parse reply.
+			switch (reply_in_ptr -> type) {
+			case RS485_REPLY_TYPE_RAW:
+				// Do not parse.
+				parser_status = PARSER_SUCCESS;
+				break;
+			case RS485_REPLY_TYPE_OK:
+				// Compare to reference string.
+				parser_status = PARSER_compare(&rs485_ctx.parser, PARSER_MODE_COMMAND, RS485_REPLY_OK);
+				break;
+			case RS485_REPLY_TYPE_VALUE:
+				// Parse value.
+				parser_status = PARSER_get_parameter(&rs485_ctx.parser, (reply_in_ptr -> format), STRING_CHAR_NULL, &(reply_out_ptr -> value));
+				break;
+			case RS485_REPLY_TYPE_ANY:
+				// First reply from the expected slave ends the sequence (content is analyzed by the caller).
+				parser_status = PARSER_SUCCESS;
+				break;
+			default:
+				status = RS485_ERROR_REPLY_TYPE;
+				goto errors;
+			}
+			// Check status.
+			if (parser_status == PARSER_SUCCESS) {
+				// Update status.
+				status = RS485_SUCCESS;
+				// In raw mode, let the function run until one of the 2 timeouts is reached.
+				// In other modes, exit as soon as the value was successfully parsed.
+				if ((reply_in_ptr -> type) != RS485_REPLY_TYPE_RAW) goto errors; // Not an error but to exit loop.
+			}
+			else {
+				status = (RS485_ERROR_BASE_PARSER + parser_status);
+			}
+			// Check error.
+			parser_status = PARSER_compare(&rs485_ctx.parser, PARSER_MODE_COMMAND, RS485_REPLY_ERROR);
+			if (parser_status == PARSER_SUCCESS) {
+				// Update output data.
+				(reply_out_ptr -> error_flag) = 1;
+				_RS485_count_reply_event(RS485_REPLY_EVENT_ERROR);
+				// Exit.
+				status = RS485_SUCCESS;
+				goto errors;
 			}
 		}
-		// Exit if timeout.
-		if (reply_time_ms > (reply_in_ptr -> timeout_ms)) {
-			// Set status to timeout if none reply has been received, otherwise the parser error code is returned.
+		// Check timer.
+		if (LPTIM1_get_timer_flag() != 0) {
+			sequence_time_ms += timer_duration_ms;
+			// Exit if sequence timeout.
+			if (sequence_time_ms >= RS485_SEQUENCE_TIMEOUT_MS) {
+				// Set status to timeout in any case.
+				status = RS485_ERROR_SEQUENCE_TIMEOUT;
+				goto errors;
+			}
+			// Reply timeout: set status to timeout if none reply has been received, otherwise the parser error code is returned.
 			if (reply_count == 0) {
 				status = RS485_ERROR_REPLY_TIMEOUT;
 			}
 			goto errors;
 		}
-		if (sequence_time_ms > RS485_SEQUENCE_TIMEOUT_MS) {
-			// Set status to timeout in any case.
-			status = RS485_ERROR_SEQUENCE_TIMEOUT;
-			goto errors;
-		}
 	}
 errors:
+	LPTIM1_stop_timer();
+	if ((status == RS485_ERROR_REPLY_TIMEOUT) || (status == RS485_ERROR_SEQUENCE_TIMEOUT)) {
+		_RS485_count_reply_event(RS485_REPLY_EVENT_TIMEOUT);
+	}
 	return status;
 }
 
@@ -259,8 +424,11 @@ errors:
  * @return:	None.
  */
 void RS485_init(void) {
-	// Reset parser.
-	_RS485_reset_replies();
+	// Reset ring.
+	rs485_ctx.rx_write_idx = 0;
+	rs485_ctx.rx_read_idx = 0;
+	_RS485_reset_rx_frame();
+	RS485_reset_statistics();
 	// Enable receiver.
 	LPUART1_enable_rx();
 }
@@ -287,6 +455,14 @@ errors:
 	return status;
 }
 
+/* GET CURRENT RS485 MODE.
+ * @param:	None.
+ * @return:	Current transmission mode.
+ */
+RS485_mode_t RS485_get_mode(void) {
+	return rs485_ctx.mode;
+}
+
 /* SEND A COMMAND ON RS485 BUS.
  * @param slave_address:	Slave address.
  * @param command:			Command to send.
@@ -305,27 +481,85 @@ RS485_status_t RS485_send_command(uint8_t slave_address, char_t* command) {
 	rs485_ctx.expected_slave_address = slave_address;
 	// Build command.
 	_RS485_build_command(command);
-	// Send command.
+	// Send command (receiver is enabled again by the TX complete callback).
 	LPUART1_disable_rx();
+	// Discard frame which may have been partially received.
+	_RS485_reset_rx_frame();
 	lpuart1_status = LPUART1_send_command(slave_address, rs485_ctx.command);
-	LPUART1_enable_rx();
+	if (LPUART1_is_tx_running() == 0) {
+		LPUART1_enable_rx();
+	}
 	LPUART1_status_check(RS485_ERROR_BASE_LPUART);
 errors:
 	return status;
 }
 
-/* SCAN ALL NODES ON RS485 BUS.
+/* SEND A COMMAND ON RS485 BUS AND WAIT FOR THE SLAVE REPLY.
+ * @param slave_address:	Slave address.
+ * @param command:			Command to send.
+ * @param transaction:		Pointer that will contain the reply and its status.
+ * @return status:			Function execution status.
+ */
+RS485_status_t RS485_send_transaction(uint8_t slave_address, char_t* command, RS485_transaction_t* transaction) {
+	// Local variables.
+	RS485_status_t status = RS485_SUCCESS;
+	RS485_reply_input_t reply_in;
+	RS485_reply_output_t reply_out;
+	// Check parameters.
+	if ((command == NULL) || (transaction == NULL)) {
+		status = RS485_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	// Reset output data.
+	(transaction -> reply) = (char_t*) rs485_ctx.reply;
+	(transaction -> reply_size) = 0;
+	(transaction -> reply_status) = RS485_REPLY_STATUS_RAW;
+	(transaction -> value) = 0;
+	(transaction -> reply_time_ms) = 0;
+	rs485_ctx.reply[0] = STRING_CHAR_NULL;
+	// Discard pending frames so that the reply can not be confused with a previous one.
+	_RS485_reset_replies();
+	status = RS485_send_command(slave_address, command);
+	if (status != RS485_SUCCESS) goto errors;
+	// Wait for the first reply.
+	reply_in.type = RS485_REPLY_TYPE_ANY;
+	reply_in.format = STRING_FORMAT_HEXADECIMAL;
+	reply_in.timeout_ms = RS485_REPLY_TIMEOUT_MS;
+	status = _RS485_wait_reply(&reply_in, &reply_out);
+	if (status != RS485_SUCCESS) goto errors;
+	// Reply data (address header has already been skipped by the parser in addressed mode).
+	(transaction -> reply) = rs485_ctx.parser.buffer;
+	(transaction -> reply_size) = (uint8_t) rs485_ctx.parser.buffer_size;
+	(transaction -> reply_time_ms) = reply_out.reply_time_ms;
+	// Analyze reply.
+	if (PARSER_compare(&rs485_ctx.parser, PARSER_MODE_COMMAND, RS485_REPLY_OK) == PARSER_SUCCESS) {
+		(transaction -> reply_status) = RS485_REPLY_STATUS_OK;
+	}
+	else if (PARSER_compare(&rs485_ctx.parser, PARSER_MODE_COMMAND, RS485_REPLY_ERROR) == PARSER_SUCCESS) {
+		(transaction -> reply_status) = RS485_REPLY_STATUS_ERROR;
+		_RS485_count_reply_event(RS485_REPLY_EVENT_ERROR);
+	}
+	else if (PARSER_get_parameter(&rs485_ctx.parser, STRING_FORMAT_HEXADECIMAL, STRING_CHAR_NULL, &(transaction -> value)) == PARSER_SUCCESS) {
+		(transaction -> reply_status) = RS485_REPLY_STATUS_VALUE;
+	}
+errors:
+	return status;
+}
+
+/* SCAN NODES ON RS485 BUS.
+ * @param first_address:			First address to probe.
+ * @param last_address:				Last address to probe (included).
  * @param nodes_list:				Node list that will be filled.
  * @param node_list_size:			Size of the list (maximum number of nodes which can be recorded).
  * @param number_of_nodes_found:	Pointer that will contain the effective number of nodes found.
  * @return status:					Function execution status.
  */
-RS485_status_t RS485_scan_nodes(RS485_node_t* nodes_list, uint8_t node_list_size, uint8_t* number_of_nodes_found) {
+RS485_status_t RS485_scan_nodes(RS485_address_t first_address, RS485_address_t last_address, RS485_node_t* nodes_list, uint8_t node_list_size, uint8_t* number_of_nodes_found) {
 	// Local variables.
 	RS485_status_t status = RS485_SUCCESS;
 	RS485_reply_input_t reply_in;
 	RS485_reply_output_t reply_out;
-	uint8_t node_address = 0;
+	uint32_t node_address = 0;
 	uint8_t node_list_idx = 0;
 	// Check parameters.
 	if ((nodes_list == NULL) || (number_of_nodes_found == NULL)) {
@@ -336,42 +570,38 @@ RS485_status_t RS485_scan_nodes(RS485_node_t* nodes_list, uint8_t node_list_size
 		status = RS485_ERROR_NULL_SIZE;
 		goto errors;
 	}
+	if ((first_address > last_address) || (last_address > RS485_ADDRESS_LAST)) {
+		status = RS485_ERROR_ADDRESS_RANGE;
+		goto errors;
+	}
 	// Reset result.
 	(*number_of_nodes_found) = 0;
-	// Build reply input common parameters.
+	// Build reply input parameters.
+	// Silent addresses are abandoned after the slave turnaround time plus the duration of the longest expected reply.
+	reply_in.type = RS485_REPLY_TYPE_VALUE;
 	reply_in.format = STRING_FORMAT_HEXADECIMAL;
-	reply_in.timeout_ms = RS485_REPLY_TIMEOUT_MS;
+	reply_in.timeout_ms = RS485_SCAN_TURNAROUND_MS + ((RS485_SCAN_REPLY_SIZE_MAX_BYTES * 10 * 1000) + LPUART1_get_baud_rate() - 1) / LPUART1_get_baud_rate();
 	// Loop on all addresses.
-	for (node_address=0 ; node_address<=RS485_ADDRESS_LAST ; node_address++) {
+	for (node_address=first_address ; node_address<=last_address ; node_address++) {
 		// Reset parser.
 		_RS485_reset_replies();
-		reply_in.type = RS485_REPLY_TYPE_OK;
-		// Send ping command.
-		status = RS485_send_command(node_address, "RS");
+		// Read board ID register: any reply means that a node is connected.
+		status = RS485_send_command((RS485_address_t) node_address, "RS$R=01");
 		if (status != RS485_SUCCESS) goto errors;
 		// Wait reply.
 		status = _RS485_wait_reply(&reply_in, &reply_out);
-		if (status == RS485_SUCCESS) {
-			// Node found (even if an error was returned after ping command).
-			(*number_of_nodes_found)++;
-			// Store address and reset board ID.
+		if ((status == RS485_SUCCESS) || ((status >= RS485_ERROR_BASE_PARSER) && (status < RS485_ERROR_BASE_LAST))) {
+			// Node found (even if the board ID could not be read).
 			if (node_list_idx < node_list_size) {
-				nodes_list[node_list_idx].address = node_address;
-				nodes_list[node_list_idx].board_id = DINFOX_BOARD_ID_ERROR;
+				nodes_list[node_list_idx].address = (RS485_address_t) node_address;
+				nodes_list[node_list_idx].board_id = ((status == RS485_SUCCESS) && (reply_out.error_flag == 0)) ? ((uint8_t) reply_out.value) : DINFOX_BOARD_ID_ERROR;
+				nodes_list[node_list_idx].reply_time_ms = (uint16_t) reply_out.reply_time_ms;
+				node_list_idx++;
 			}
-			// Reset parser.
-			_RS485_reset_replies();
-			reply_in.type = RS485_REPLY_TYPE_VALUE;
-			// Get board ID.
-			status = RS485_send_command(node_address, "RS$R=01");
-			if (status != RS485_SUCCESS) goto errors;
-			// Wait reply.
-			status = _RS485_wait_reply(&reply_in, &reply_out);
-			if ((status == RS485_SUCCESS) && (reply_out.error_flag == 0)) {
-				// Update board ID.
-				nodes_list[node_list_idx].board_id = (uint8_t) reply_out.value;
-			}
-			node_list_idx++;
+			(*number_of_nodes_found)++;
+		}
+		else {
+			if ((status != RS485_ERROR_REPLY_TIMEOUT) && (status != RS485_ERROR_SEQUENCE_TIMEOUT) && (status != RS485_ERROR_SOURCE_ADDRESS_MISMATCH)) goto errors;
 		}
 		IWDG_reload();
 	}
@@ -385,15 +615,99 @@ errors:
  * @return:	None.
  */
 void RS485_task(void) {
-	// Check line end flag on current reply.
-	while (rs485_ctx.reply[rs485_ctx.reply_read_idx].line_end_flag != 0) {
-		// Print frame.
-		AT_print_rs485_frame((char_t*) rs485_ctx.reply[rs485_ctx.reply_read_idx].buffer, rs485_ctx.reply[rs485_ctx.reply_read_idx].size);
-		// Reset reply.
-		_RS485_reset_reply(rs485_ctx.reply_read_idx);
-		// Increment read index.
-		rs485_ctx.reply_read_idx = (rs485_ctx.reply_read_idx + 1) % RS485_REPLY_BUFFER_DEPTH;
+	// Print all received frames.
+	while (_RS485_read_reply() != 0) {
+		AT_print_rs485_frame(rs485_ctx.reply, rs485_ctx.reply_size);
+	}
+}
+
+/* GET NUMBER OF DROPPED FRAMES.
+ * @param:	None.
+ * @return:	Number of received frames which did not fit in the reception ring since init.
+ */
+uint32_t RS485_get_rx_dropped_frames(void) {
+	return rs485_ctx.statistics.rx_dropped_frames;
+}
+
+/* READ TRAFFIC STATISTICS.
+ * @param address:		Node address, or RS485_STATISTICS_BUS to read bus-wide counters.
+ * @param statistics:	Pointer that will contain the statistics.
+ * @return status:		Function execution status.
+ * Note: counters of a node which has never been seen on the bus are zero.
+ */
+RS485_status_t RS485_get_statistics(uint8_t address, RS485_statistics_t* statistics) {
+	// Local variables.
+	RS485_status_t status = RS485_SUCCESS;
+	RS485_node_statistics_t* node_statistics = NULL;
+	uint32_t primask = 0;
+	uint8_t idx = 0;
+	// Check parameters.
+	if (statistics == NULL) {
+		status = RS485_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	if ((address > RS485_ADDRESS_LAST) && (address != RS485_STATISTICS_BUS)) {
+		status = RS485_ERROR_ADDRESS_RANGE;
+		goto errors;
+	}
+	// Copy counters with interrupts masked since they are updated by the LPUART interrupt (previous PRIMASK is restored).
+	__asm volatile ("mrs %0, primask" : "=r" (primask));
+	__asm volatile ("cpsid i");
+	if (address == RS485_STATISTICS_BUS) {
+		(*statistics) = rs485_ctx.statistics;
+		(statistics -> rx_overruns) = LPUART1_get_rx_overruns();
+	}
+	else {
+		for (idx=0 ; idx<rs485_ctx.node_statistics_count ; idx++) {
+			if (rs485_ctx.node_statistics[idx].address == address) {
+				node_statistics = &(rs485_ctx.node_statistics[idx]);
+				break;
+			}
+		}
+		(statistics -> rx_frames) = (node_statistics != NULL) ? (node_statistics -> rx_frames) : 0;
+		(statistics -> rx_bytes) = (node_statistics != NULL) ? (node_statistics -> rx_bytes) : 0;
+		(statistics -> rx_overruns) = 0;
+		(statistics -> rx_truncated_frames) = (node_statistics != NULL) ? (node_statistics -> rx_truncated_frames) : 0;
+		(statistics -> rx_dropped_frames) = 0;
+		(statistics -> reply_timeouts) = (node_statistics != NULL) ? (node_statistics -> reply_timeouts) : 0;
+		(statistics -> address_mismatches) = (node_statistics != NULL) ? (node_statistics -> address_mismatches) : 0;
+		(statistics -> error_replies) = (node_statistics != NULL) ? (node_statistics -> error_replies) : 0;
 	}
+	__asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+errors:
+	return status;
+}
+
+/* RESET ALL TRAFFIC STATISTICS.
+ * @param:	None.
+ * @return:	None.
+ */
+void RS485_reset_statistics(void) {
+	// Local variables.
+	uint32_t primask = 0;
+	// Reset bus-wide counters and release all node slots (previous PRIMASK is restored).
+	__asm volatile ("mrs %0, primask" : "=r" (primask));
+	__asm volatile ("cpsid i");
+	rs485_ctx.statistics.rx_frames = 0;
+	rs485_ctx.statistics.rx_bytes = 0;
+	rs485_ctx.statistics.rx_overruns = 0;
+	rs485_ctx.statistics.rx_truncated_frames = 0;
+	rs485_ctx.statistics.rx_dropped_frames = 0;
+	rs485_ctx.statistics.reply_timeouts = 0;
+	rs485_ctx.statistics.address_mismatches = 0;
+	rs485_ctx.statistics.error_replies = 0;
+	rs485_ctx.node_statistics_count = 0;
+	LPUART1_reset_rx_overruns();
+	__asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+}
+
+/* RS485 TRANSMISSION END CALLBACK (CALLED BY LPUART INTERRUPT).
+ * @param:	None.
+ * @return:	None.
+ */
+void RS485_tx_complete(void) {
+	// Enable receiver to get reply.
+	LPUART1_enable_rx();
 }
 
 /* FILL RS485 BUFFER WITH A NEW BYTE (CALLED BY LPUART INTERRUPT).
@@ -401,21 +715,59 @@ void RS485_task(void) {
  * @return:			None.
  */
 void RS485_fill_rx_buffer(uint8_t rx_byte) {
-	// Read current index.
-	uint8_t idx = rs485_ctx.reply[rs485_ctx.reply_write_idx].size;
+	// Local variables.
+	RS485_node_statistics_t* node_statistics = NULL;
+	uint32_t write_idx = 0;
+	uint32_t free_size = 0;
+	// Compute ring space after the frame start (one byte is kept free to distinguish full and empty states).
+	free_size = (rs485_ctx.rx_read_idx - rs485_ctx.rx_frame_start_idx - 1) & (RS485_RX_RING_SIZE_BYTES - 1);
 	// Check ending characters.
 	if (rx_byte == RS485_FRAME_END) {
-		// Set flag on current buffer.
-		rs485_ctx.reply[rs485_ctx.reply_write_idx].buffer[idx] = STRING_CHAR_NULL;
-		rs485_ctx.reply[rs485_ctx.reply_write_idx].line_end_flag = 1;
-		// Switch buffer.
-		rs485_ctx.reply_write_idx = (rs485_ctx.reply_write_idx + 1) % RS485_REPLY_BUFFER_DEPTH;
+		// Get source node statistics (source address is stored after the length and destination address bytes).
+		if ((rs485_ctx.mode == RS485_MODE_ADDRESSED) && (rs485_ctx.rx_frame_size > RS485_FRAME_FIELD_INDEX_SOURCE_ADDRESS)) {
+			node_statistics = _RS485_get_node_statistics((rs485_ctx.rx_ring[(rs485_ctx.rx_frame_start_idx + 1 + RS485_FRAME_FIELD_INDEX_SOURCE_ADDRESS) & (RS485_RX_RING_SIZE_BYTES - 1)] & RS485_ADDRESS_MASK), 1);
+		}
+		// Commit frame (or discard it if the length byte and data did not fit).
+		write_idx = (rs485_ctx.rx_frame_start_idx + 1 + rs485_ctx.rx_frame_size) & (RS485_RX_RING_SIZE_BYTES - 1);
+		if ((rs485_ctx.rx_frame_overflow == 0) && (free_size >= (1 + (uint32_t) rs485_ctx.rx_frame_size))) {
+			rs485_ctx.rx_ring[rs485_ctx.rx_frame_start_idx] = rs485_ctx.rx_frame_size;
+			rs485_ctx.rx_write_idx = write_idx;
+			EVENT_post(EVENT_RS485_RX);
+			// Update statistics.
+			rs485_ctx.statistics.rx_frames++;
+			rs485_ctx.statistics.rx_bytes += rs485_ctx.rx_frame_size;
+			if (node_statistics != NULL) {
+				(node_statistics -> rx_frames)++;
+				(node_statistics -> rx_bytes) += rs485_ctx.rx_frame_size;
+			}
+		}
+		else {
+			rs485_ctx.statistics.rx_dropped_frames++;
+			if (rs485_ctx.rx_frame_truncated != 0) {
+				rs485_ctx.statistics.rx_truncated_frames++;
+				if (node_statistics != NULL) (node_statistics -> rx_truncated_frames)++;
+			}
+		}
+		// Start next frame.
+		rs485_ctx.rx_frame_start_idx = rs485_ctx.rx_write_idx;
+		rs485_ctx.rx_frame_size = 0;
+		rs485_ctx.rx_frame_overflow = 0;
+		rs485_ctx.rx_frame_truncated = 0;
 	}
 	else {
-		// Store incoming byte.
-		rs485_ctx.reply[rs485_ctx.reply_write_idx].buffer[idx] = rx_byte;
-		// Manage index.
-		idx = (idx + 1) % RS485_BUFFER_SIZE_BYTES;
-		rs485_ctx.reply[rs485_ctx.reply_write_idx].size = idx;
+		// Check frame size and ring space (length byte, stored data and incoming byte).
+		write_idx = (rs485_ctx.rx_frame_start_idx + 1 + rs485_ctx.rx_frame_size) & (RS485_RX_RING_SIZE_BYTES - 1);
+		if (rs485_ctx.rx_frame_size >= (RS485_BUFFER_SIZE_BYTES - 1)) {
+			rs485_ctx.rx_frame_overflow = 1;
+			rs485_ctx.rx_frame_truncated = 1;
+		}
+		if (free_size < (2 + (uint32_t) rs485_ctx.rx_frame_size)) {
+			rs485_ctx.rx_frame_overflow = 1;
+		}
+		if (rs485_ctx.rx_frame_overflow == 0) {
+			// Store incoming byte.
+			rs485_ctx.rx_ring[write_idx] = rx_byte;
+			rs485_ctx.rx_frame_size++;
+		}
 	}
 }
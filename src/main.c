@@ -18,8 +18,14 @@
 #include "pwr.h"
 #include "rcc.h"
 #include "rtc.h"
+// Utils.
+#include "event.h"
+#include "prof.h"
+// Components.
+#include "rs485.h"
 // Applicative.
 #include "at.h"
+#include "config.h"
 #include "error.h"
 
 /*** MAIN local structures ***/
@@ -71,6 +77,9 @@ static void DIM_init_hw(void) {
 	LPUART_status_t lpuart1_status = LPUART_SUCCESS;
 	NVM_status_t nvm_status = NVM_SUCCESS;
 	RS485_address_t node_address;
+	uint32_t rs485_baud_rate = 0;
+	uint32_t host_baud_rate = 0;
+	USART_status_t usart_status = USART_SUCCESS;
 #ifndef DEBUG
 	IWDG_status_t iwdg_status = IWDG_SUCCESS;
 #endif
@@ -116,17 +125,43 @@ static void DIM_init_hw(void) {
 	if (dim_ctx.lse_running == 0) {
 		dim_ctx.status.lse_status = 0;
 	}
+#ifdef PWR_STATISTICS
+	// Start power states measurement.
+	PWR_reset_statistics();
+#endif
+#ifdef PROFILING
+	// Start hot paths profiling.
+	PROF_init();
+#endif
 	IWDG_reload();
 	// Read RS485 address in NVM.
 	nvm_status = NVM_read_byte(NVM_ADDRESS_RS485_ADDRESS, &node_address);
 	NVM_error_check();
+	// Read baud rates in NVM.
+	nvm_status = NVM_read_word(NVM_ADDRESS_RS485_BAUD_RATE, &rs485_baud_rate);
+	NVM_error_check();
+	nvm_status = NVM_read_word(NVM_ADDRESS_HOST_BAUD_RATE, &host_baud_rate);
+	NVM_error_check();
 	// Init peripherals.
 	LPTIM1_init(dim_ctx.lsi_frequency_hz);
 	adc1_status = ADC1_init();
 	ADC1_error_check();
 	lpuart1_status = LPUART1_init(node_address);
 	LPUART1_error_check();
+	// Apply stored baud rate (default rate is kept if the NVM field is blank).
+	if (rs485_baud_rate != 0) {
+		lpuart1_status = LPUART1_set_baud_rate(rs485_baud_rate);
+		LPUART1_error_check();
+	}
 	USART2_init();
+	// Apply stored host baud rate (it has already been confirmed by the host before being saved).
+	if (host_baud_rate != 0) {
+		usart_status = USART2_set_baud_rate(host_baud_rate);
+		USART_error_check();
+		USART2_confirm_baud_rate();
+	}
+	// Read DIP switch.
+	CONFIG_init();
 	// Init AT interface.
 	AT_init();
 }
@@ -138,17 +173,53 @@ static void DIM_init_hw(void) {
  * @return:	None.
  */
 int main(void) {
+	// Local variables.
+	ADC_status_t adc1_status = ADC_SUCCESS;
 	// Init board.
 	DIM_init_context();
 	DIM_init_hw();
 	// Start periodic wakeup timer.
 	RTC_start_wakeup_timer(RTC_WAKEUP_PERIOD_SECONDS);
-	// Main loop.
+	// Main loop: tasks run to completion only when their event is pending.
 	while (1) {
-		// Enter sleep mode.
-		PWR_enter_sleep_mode();
-		// Wake-up.
-		AT_task();
+		// Interrupts are masked while checking events so that an event posted just before WFI can not be missed.
+		// A pending interrupt still exits low power mode, it is then executed as soon as interrupts are unmasked.
+		__asm volatile ("cpsid i");
+		if (EVENT_is_pending() == 0) {
+			// Enter stop mode only if both interfaces are idle (any other peripheral interrupt can not exit stop mode).
+			USART2_enable_wake_up();
+			LPUART1_enable_wake_up();
+			if ((USART2_is_idle() != 0) && (LPUART1_is_idle() != 0)) {
+				PWR_enter_stop_mode();
+			}
+			else {
+				PWR_enter_sleep_mode();
+			}
+			USART2_disable_wake_up();
+			LPUART1_disable_wake_up();
+		}
+		__asm volatile ("cpsie i");
+		// Host interface.
+		if (EVENT_take(EVENT_HOST_RX) != 0) {
+			AT_task();
+		}
+		// Bus sniffer.
+		if (EVENT_take(EVENT_RS485_RX) != 0) {
+			RS485_task();
+		}
+		// Periodic tasks.
+		if (EVENT_take(EVENT_RTC_WAKEUP) != 0) {
+			// Refresh analog measurements in background so that register reads use cached data.
+			adc1_status = ADC1_update_data(RTC_WAKEUP_PERIOD_SECONDS * 1000);
+			ADC1_error_check();
+			// Sample DIP switch (pull-up is only enabled during sampling).
+			CONFIG_update_tx_mode();
+			AT_task();
+		}
+		// Resumable scan (lowest priority, one address per loop).
+		if (EVENT_take(EVENT_NODE_SCAN) != 0) {
+			AT_scan_task();
+		}
 		IWDG_reload();
 	}
 }
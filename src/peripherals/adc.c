@@ -8,16 +8,27 @@
 #include "adc.h"
 
 #include "adc_reg.h"
+#include "dma.h"
 #include "lptim.h"
 #include "mapping.h"
 #include "math.h"
+#include "mode.h"
+#include "prof.h"
+#include "pwr.h"
 #include "rcc_reg.h"
+#include "rtc.h"
 #include "types.h"
 
 /*** ADC local macros ***/
 
+#ifdef ADC_USE_HW_OVERSAMPLING
+#define ADC_NUMBER_OF_SEQUENCES			1
+#else
 #define ADC_MEDIAN_FILTER_SIZE			9
 #define ADC_CENTER_AVERAGE_SIZE			3
+#define ADC_NUMBER_OF_SEQUENCES			ADC_MEDIAN_FILTER_SIZE
+#endif
+#define ADC_SAMPLE_BUFFER_SIZE			(ADC_NUMBER_OF_SEQUENCES * ADC_SEQUENCE_INDEX_LAST)
 
 #define ADC_FULL_SCALE_12BITS			4095
 
@@ -25,10 +36,13 @@
 #define ADC_VMCU_DEFAULT_MV				3300
 
 #define ADC_TIMEOUT_COUNT				1000000
+#define ADC_DMA_TIMEOUT_MS				100
 
 #define ADC_VOLTAGE_DIVIDER_RATIO_VUSB	2
 #define ADC_VOLTAGE_DIVIDER_RATIO_VRS	2
 
+#define ADC_DATA_MAX_AGE_DEFAULT_S		60
+
 /*** ADC local structures ***/
 
 typedef enum {
@@ -39,10 +53,23 @@ typedef enum {
 	ADC_CHANNEL_LAST = 19
 } ADC_channel_t;
 
+// Channels are converted by ascending number (SCANDIR='0'), each sequence is stored in this order.
+typedef enum {
+	ADC_SEQUENCE_INDEX_VRS = 0,
+	ADC_SEQUENCE_INDEX_VUSB,
+	ADC_SEQUENCE_INDEX_VREFINT,
+	ADC_SEQUENCE_INDEX_TMCU,
+	ADC_SEQUENCE_INDEX_LAST
+} ADC_sequence_index_t;
+
 typedef struct {
+	uint16_t sample_buf[ADC_SAMPLE_BUFFER_SIZE];
 	uint32_t vrefint_12bits;
 	uint32_t data[ADC_DATA_INDEX_LAST];
 	int8_t tmcu_degrees;
+	uint8_t data_valid;
+	uint32_t data_timestamp_ms;
+	uint32_t data_max_age_s;
 } ADC_context_t;
 
 /*** ADC local global variables ***/
@@ -51,57 +78,67 @@ static ADC_context_t adc_ctx;
 
 /*** ADC local functions ***/
 
-/* PERFORM A SINGLE ADC CONVERSION.
- * @param adc_channel:			Channel to convert.
- * @param adc_result_12bits:	Pointer to 32-bits value that will contain ADC raw result on 12 bits.
- * @return status:				Function execution status.
+/* CONVERT ALL CHANNELS IN A SINGLE HARDWARE SEQUENCE.
+ * @param:			None.
+ * @return status:	Function execution status.
+ * Note: results are transfered by DMA in the sample buffer while the core sleeps.
  */
-static ADC_status_t _ADC1_single_conversion(ADC_channel_t adc_channel, uint32_t* adc_result_12bits) {
+static ADC_status_t _ADC1_perform_sequences(void) {
 	// Local variables.
 	ADC_status_t status = ADC_SUCCESS;
+	LPTIM_status_t lptim1_status = LPTIM_SUCCESS;
 	uint32_t loop_count = 0;
-	// Check parameters.
-	if (adc_channel >= ADC_CHANNEL_LAST) {
-		status = ADC_ERROR_CHANNEL;
-		goto errors;
-	}
-	if (adc_result_12bits == NULL) {
-		status = ADC_ERROR_NULL_PARAMETER;
-		goto errors;
-	}
-	// Select input channel.
+	// Select all input channels.
 	ADC1 -> CHSELR &= 0xFFF80000; // Reset all bits.
-	ADC1 -> CHSELR |= (0b1 << adc_channel);
+	ADC1 -> CHSELR |= (0b1 << ADC_CHANNEL_VRS) | (0b1 << ADC_CHANNEL_VUSB) | (0b1 << ADC_CHANNEL_VREFINT) | (0b1 << ADC_CHANNEL_TMCU);
+	// Configure DMA transfer.
+	DMA1_CH1_stop();
+	DMA1_CH1_set_destination_address((uint32_t) adc_ctx.sample_buf, ADC_SAMPLE_BUFFER_SIZE);
+	DMA1_CH1_start();
 	// Clear all flags.
 	ADC1 -> ISR |= 0x0000089F;
-	// Read raw supply voltage.
+	// Start conversions and timeout timer.
+	lptim1_status = LPTIM1_start_timer(ADC_DMA_TIMEOUT_MS);
+	LPTIM1_status_check(ADC_ERROR_BASE_LPTIM);
 	ADC1 -> CR |= (0b1 << 2); // ADSTART='1'.
-	while (((ADC1 -> ISR) & (0b1 << 2)) == 0) {
-		// Wait end of conversion ('EOC='1') or timeout.
-		loop_count++;
-		if (loop_count > ADC_TIMEOUT_COUNT) {
+	// Enter sleep mode until all samples are transfered.
+	while (DMA1_CH1_get_transfer_status() == 0) {
+		PWR_enter_sleep_mode();
+		if (LPTIM1_get_timer_flag() != 0) {
 			status = ADC_ERROR_TIMEOUT;
 			goto errors;
 		}
 	}
-	(*adc_result_12bits) = (ADC1 -> DR);
 errors:
+	LPTIM1_stop_timer();
+	// Stop continuous conversions.
+	if (((ADC1 -> CR) & (0b1 << 2)) != 0) {
+		ADC1 -> CR |= (0b1 << 4); // ADSTP='1'.
+		while (((ADC1 -> CR) & (0b1 << 4)) != 0) {
+			// Wait for conversions to stop (ADSTP='0') or timeout.
+			loop_count++;
+			if (loop_count > ADC_TIMEOUT_COUNT) break;
+		}
+	}
+	DMA1_CH1_stop();
 	return status;
 }
 
-/* PERFORM SEVERAL CONVERSIONS FOLLOWED BY A MEDIAN FILTER.
- * @param adc_channel:			Channel to convert.
+/* GET THE FILTERED RESULT OF A CHANNEL.
+ * @param sequence_idx:			Index of the channel in the sequence.
  * @param adc_result_12bits:	Pointer to 32-bits value that will contain ADC filtered result on 12 bits.
  * @return status:				Function execution status.
  */
-static ADC_status_t _ADC1_filtered_conversion(ADC_channel_t adc_channel, uint32_t* adc_result_12bits) {
+static ADC_status_t _ADC1_get_filtered_result(ADC_sequence_index_t sequence_idx, uint32_t* adc_result_12bits) {
 	// Local variables.
 	ADC_status_t status = ADC_SUCCESS;
+#ifndef ADC_USE_HW_OVERSAMPLING
 	MATH_status_t math_status = MATH_SUCCESS;
 	uint32_t adc_sample_buf[ADC_MEDIAN_FILTER_SIZE] = {0x00};
 	uint8_t idx = 0;
+#endif
 	// Check parameters.
-	if (adc_channel >= ADC_CHANNEL_LAST) {
+	if (sequence_idx >= ADC_SEQUENCE_INDEX_LAST) {
 		status = ADC_ERROR_CHANNEL;
 		goto errors;
 	}
@@ -109,27 +146,31 @@ static ADC_status_t _ADC1_filtered_conversion(ADC_channel_t adc_channel, uint32_
 		status = ADC_ERROR_NULL_PARAMETER;
 		goto errors;
 	}
-	// Perform all conversions.
+#ifdef ADC_USE_HW_OVERSAMPLING
+	// Result is already averaged by hardware.
+	(*adc_result_12bits) = (uint32_t) adc_ctx.sample_buf[sequence_idx];
+#else
+	// Extract channel samples from all sequences.
 	for (idx=0 ; idx<ADC_MEDIAN_FILTER_SIZE ; idx++) {
-		status = _ADC1_single_conversion(adc_channel, &(adc_sample_buf[idx]));
-		if (status != ADC_SUCCESS) goto errors;
+		adc_sample_buf[idx] = (uint32_t) adc_ctx.sample_buf[(idx * ADC_SEQUENCE_INDEX_LAST) + sequence_idx];
 	}
 	// Apply median filter.
 	math_status = MATH_median_filter_u32(adc_sample_buf, ADC_MEDIAN_FILTER_SIZE, ADC_CENTER_AVERAGE_SIZE, adc_result_12bits);
 	MATH_status_check(ADC_ERROR_BASE_MATH);
+#endif
 errors:
 	return status;
 }
 
-/* PERFORM INTERNAL REFERENCE VOLTAGE CONVERSION.
+/* COMPUTE INTERNAL REFERENCE VOLTAGE.
  * @param:			None.
  * @return status:	Function execution status.
  */
 static ADC_status_t _ADC1_compute_vrefint(void) {
 	// Local variables.
 	ADC_status_t status = ADC_SUCCESS;
-	// Read raw reference voltage.
-	status = _ADC1_filtered_conversion(ADC_CHANNEL_VREFINT, &adc_ctx.vrefint_12bits);
+	// Get raw reference voltage.
+	status = _ADC1_get_filtered_result(ADC_SEQUENCE_INDEX_VREFINT, &adc_ctx.vrefint_12bits);
 	return status;
 }
 
@@ -152,8 +193,8 @@ static ADC_status_t _ADC1_compute_tmcu(void) {
 	uint32_t raw_temp_sensor_12bits = 0;
 	int32_t raw_temp_calib_mv = 0;
 	int32_t temp_calib_degrees = 0;
-	// Read raw temperature.
-	status = _ADC1_filtered_conversion(ADC_CHANNEL_TMCU, &raw_temp_sensor_12bits);
+	// Get raw temperature.
+	status = _ADC1_get_filtered_result(ADC_SEQUENCE_INDEX_TMCU, &raw_temp_sensor_12bits);
 	if (status != ADC_SUCCESS) goto errors;
 	// Compute temperature according to MCU factory calibration (see p.301 and p.847 of RM0377 datasheet).
 	raw_temp_calib_mv = ((int32_t) raw_temp_sensor_12bits * adc_ctx.data[ADC_DATA_INDEX_VMCU_MV]) / (TS_VCC_CALIB_MV) - TS_CAL1; // Equivalent raw measure for calibration power supply (VCC_CALIB).
@@ -173,7 +214,7 @@ static ADC_status_t _ADC1_compute_vusb(void) {
 	ADC_status_t status = ADC_SUCCESS;
 	uint32_t vusb_12bits = 0;
 	// Get raw result.
-	status = _ADC1_filtered_conversion(ADC_CHANNEL_VUSB, &vusb_12bits);
+	status = _ADC1_get_filtered_result(ADC_SEQUENCE_INDEX_VUSB, &vusb_12bits);
 	if (status != ADC_SUCCESS) goto errors;
 	// Convert to mV using bandgap result.
 	adc_ctx.data[ADC_DATA_INDEX_VUSB_MV] = (ADC_VREFINT_VOLTAGE_MV * vusb_12bits * ADC_VOLTAGE_DIVIDER_RATIO_VUSB) / (adc_ctx.vrefint_12bits);
@@ -190,7 +231,7 @@ static ADC_status_t _ADC1_compute_vrs(void) {
 	ADC_status_t status = ADC_SUCCESS;
 	uint32_t vrs_12bits = 0;
 	// Get raw result.
-	status = _ADC1_filtered_conversion(ADC_CHANNEL_VRS, &vrs_12bits);
+	status = _ADC1_get_filtered_result(ADC_SEQUENCE_INDEX_VRS, &vrs_12bits);
 	if (status != ADC_SUCCESS) goto errors;
 	// Convert to mV using bandgap result.
 	adc_ctx.data[ADC_DATA_INDEX_VRS_MV] = (ADC_VREFINT_VOLTAGE_MV * vrs_12bits * ADC_VOLTAGE_DIVIDER_RATIO_VRS) / (adc_ctx.vrefint_12bits);
@@ -198,6 +239,27 @@ errors:
 	return status;
 }
 
+/* COMPUTE ALL DATA FROM THE CONVERSIONS RESULTS.
+ * @param:			None.
+ * @return status:	Function execution status.
+ */
+static ADC_status_t _ADC1_compute_data(void) {
+	// Local variables.
+	ADC_status_t status = ADC_SUCCESS;
+	// Bandgap result is required first to convert the other channels.
+	status = _ADC1_compute_vrefint();
+	if (status != ADC_SUCCESS) goto errors;
+	_ADC1_compute_vmcu();
+	status = _ADC1_compute_tmcu();
+	if (status != ADC_SUCCESS) goto errors;
+	status = _ADC1_compute_vusb();
+	if (status != ADC_SUCCESS) goto errors;
+	status = _ADC1_compute_vrs();
+	if (status != ADC_SUCCESS) goto errors;
+errors:
+	return status;
+}
+
 /*** ADC functions ***/
 
 /* INIT ADC1 PERIPHERAL.
@@ -215,6 +277,9 @@ ADC_status_t ADC1_init(void) {
 	for (idx=0 ; idx<ADC_DATA_INDEX_LAST ; idx++) adc_ctx.data[idx] = 0;
 	adc_ctx.data[ADC_DATA_INDEX_VMCU_MV] = ADC_VMCU_DEFAULT_MV;
 	adc_ctx.tmcu_degrees = 0;
+	adc_ctx.data_valid = 0;
+	adc_ctx.data_timestamp_ms = 0;
+	adc_ctx.data_max_age_s = ADC_DATA_MAX_AGE_DEFAULT_S;
 	// Init GPIOs.
 	GPIO_configure(&GPIO_ADC1_IN4, GPIO_MODE_ANALOG, GPIO_TYPE_OPEN_DRAIN, GPIO_SPEED_LOW, GPIO_PULL_NONE);
 	GPIO_configure(&GPIO_ADC1_IN5, GPIO_MODE_ANALOG, GPIO_TYPE_OPEN_DRAIN, GPIO_SPEED_LOW, GPIO_PULL_NONE);
@@ -231,6 +296,8 @@ ADC_status_t ADC1_init(void) {
 	ADC1 -> CR |= (0b1 << 28);
 	lptim1_status = LPTIM1_delay_milliseconds(5, 0);
 	LPTIM1_status_check(ADC_ERROR_BASE_LPTIM);
+	// Init DMA channel.
+	DMA1_CH1_init();
 	// ADC configuration.
 	ADC1 -> CFGR2 |= (0b01 << 30); // Use (PCLK2/2) as ADCCLK = SYSCLK/2 (see RCC_init() function).
 	ADC1 -> SMPR |= (0b111 << 0); // Maximum sampling time.
@@ -244,6 +311,15 @@ ADC_status_t ADC1_init(void) {
 			break;
 		}
 	}
+	// Sequence configuration (must be done after calibration since DMAEN must be cleared during calibration).
+	ADC1 -> CFGR1 |= (0b1 << 0); // DMA requests enabled in one-shot mode (DMAEN='1' and DMACFG='0').
+#ifdef ADC_USE_HW_OVERSAMPLING
+	// Single sequence with 16 samples averaged by hardware (OVSR='011' and OVSS='0100').
+	ADC1 -> CFGR2 |= (0b0100 << 5) | (0b011 << 2) | (0b1 << 0); // OVSE='1'.
+#else
+	// Continuous mode to chain all sequences.
+	ADC1 -> CFGR1 |= (0b1 << 13); // CONT='1'.
+#endif
 errors:
 	return status;
 }
@@ -277,14 +353,16 @@ ADC_status_t ADC1_perform_measurements(void) {
 	lptim1_status = LPTIM1_delay_milliseconds(100, 0);
 	LPTIM1_status_check(ADC_ERROR_BASE_LPTIM);
 	// Perform measurements.
-	status = _ADC1_compute_vrefint();
-	if (status != ADC_SUCCESS) goto errors;
-	_ADC1_compute_vmcu();
-	status = _ADC1_compute_tmcu();
+	status = _ADC1_perform_sequences();
 	if (status != ADC_SUCCESS) goto errors;
-	status = _ADC1_compute_vusb();
+	// Only the filtering and conversion code is profiled (stabilization delay and DMA sleep are excluded).
+	PROF_enter(PROF_PROBE_ADC1_COMPUTE);
+	status = _ADC1_compute_data();
+	PROF_exit(PROF_PROBE_ADC1_COMPUTE);
 	if (status != ADC_SUCCESS) goto errors;
-	status = _ADC1_compute_vrs();
+	// Update cache timestamp.
+	adc_ctx.data_valid = 1;
+	adc_ctx.data_timestamp_ms = RTC_get_time_ms();
 errors:
 	// Switch internal voltage reference off.
 	ADC1 -> CCR &= ~(0b11 << 22); // TSEN='0' and VREFEF='0'.
@@ -297,6 +375,67 @@ errors:
 	return status;
 }
 
+/* PERFORM INTERNAL ADC MEASUREMENTS ONLY IF CACHED DATA IS STALE.
+ * @param anticipation_ms:	Data is also refreshed if it becomes stale within this delay.
+ * @return status:			Function execution status.
+ * Note: a maximum age of zero disables the cache (measurements are always performed).
+ */
+ADC_status_t ADC1_update_data(uint32_t anticipation_ms) {
+	// Local variables.
+	ADC_status_t status = ADC_SUCCESS;
+	// Check cache validity.
+	if ((adc_ctx.data_valid == 0) || ((RTC_get_duration_ms(adc_ctx.data_timestamp_ms, RTC_get_time_ms()) + anticipation_ms) >= (adc_ctx.data_max_age_s * 1000))) {
+		status = ADC1_perform_measurements();
+	}
+	return status;
+}
+
+/* SET THE MAXIMUM AGE OF CACHED ADC DATA.
+ * @param max_age_s:	Maximum age in seconds.
+ * @return status:		Function execution status.
+ */
+ADC_status_t ADC1_set_data_max_age(uint32_t max_age_s) {
+	// Local variables.
+	ADC_status_t status = ADC_SUCCESS;
+	// Check parameter.
+	if (max_age_s > ADC_DATA_MAX_AGE_MAX_S) {
+		status = ADC_ERROR_DATA_MAX_AGE;
+		goto errors;
+	}
+	adc_ctx.data_max_age_s = max_age_s;
+errors:
+	return status;
+}
+
+/* GET THE MAXIMUM AGE OF CACHED ADC DATA.
+ * @param:				None.
+ * @return max_age_s:	Maximum age in seconds.
+ */
+uint32_t ADC1_get_data_max_age(void) {
+	return adc_ctx.data_max_age_s;
+}
+
+/* GET THE AGE OF CACHED ADC DATA.
+ * @param data_age_ms:	Pointer that will contain the time elapsed since the last measurements in ms.
+ * @return status:		Function execution status.
+ */
+ADC_status_t ADC1_get_data_age(uint32_t* data_age_ms) {
+	// Local variables.
+	ADC_status_t status = ADC_SUCCESS;
+	// Check parameters.
+	if (data_age_ms == NULL) {
+		status = ADC_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	if (adc_ctx.data_valid == 0) {
+		status = ADC_ERROR_DATA_INVALID;
+		goto errors;
+	}
+	(*data_age_ms) = RTC_get_duration_ms(adc_ctx.data_timestamp_ms, RTC_get_time_ms());
+errors:
+	return status;
+}
+
 /* GET ADC DATA.
  * @param data_idx:	Index of the data to retrieve.
  * @param data:		Pointer that will contain ADC data.
@@ -0,0 +1,265 @@
+/*
+ * dma.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "dma.h"
+
+#include "adc_reg.h"
+#include "dma_reg.h"
+#include "lpuart.h"
+#include "lpuart_reg.h"
+#include "nvic.h"
+#include "rcc_reg.h"
+#include "usart.h"
+#include "usart_reg.h"
+#include "types.h"
+
+/*** DMA local global variables ***/
+
+static volatile uint8_t dma1_ch1_tc_flag = 0;
+
+/*** DMA local functions ***/
+
+/* DMA1 CHANNEL 1 INTERRUPT HANDLER.
+ * @param:	None.
+ * @return:	None.
+ */
+void __attribute__((optimize("-O0"))) DMA1_Channel1_IRQHandler(void) {
+	// Transfer complete interrupt.
+	if (((DMA1 -> ISR) & (0b1 << 1)) != 0) {
+		// Set local flag.
+		if (((DMA1 -> CH[0].CCR) & (0b1 << 1)) != 0) {
+			dma1_ch1_tc_flag = 1;
+		}
+		// Clear flag.
+		DMA1 -> IFCR |= (0b1 << 1); // CTCIF1='1'.
+	}
+}
+
+/* DMA1 CHANNELS 2 AND 3 INTERRUPT HANDLER.
+ * @param:	None.
+ * @return:	None.
+ */
+void __attribute__((optimize("-O0"))) DMA1_Channel2_3_IRQHandler(void) {
+	// Channel 3 half transfer or transfer complete interrupts.
+	if (((DMA1 -> ISR) & (0b11 << 9)) != 0) {
+		// Clear flags.
+		DMA1 -> IFCR |= (0b11 << 9); // CHTIF3='1' and CTCIF3='1'.
+		// Process received bytes before the circular buffer wraps.
+		LPUART1_process_rx_dma();
+	}
+}
+
+/* DMA1 CHANNELS 4 TO 7 INTERRUPT HANDLER.
+ * @param:	None.
+ * @return:	None.
+ */
+void __attribute__((optimize("-O0"))) DMA1_Channel4_5_6_7_IRQHandler(void) {
+	// Channel 5 half transfer or transfer complete interrupts.
+	if (((DMA1 -> ISR) & (0b11 << 17)) != 0) {
+		// Clear flags.
+		DMA1 -> IFCR |= (0b11 << 17); // CHTIF5='1' and CTCIF5='1'.
+		// Process received bytes before the circular buffer wraps.
+		USART2_process_rx_dma();
+	}
+}
+
+/*** DMA functions ***/
+
+/* CONFIGURE DMA1 CHANNEL 1 FOR ADC DATA TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH1_init(void) {
+	// Enable peripheral clock.
+	RCC -> AHBENR |= (0b1 << 0); // DMAEN='1'.
+	// Disable channel before configuration.
+	DMA1 -> CH[0].CCR &= ~(0b1 << 0); // EN='0'.
+	// Memory and peripheral data size are 16 bits (MSIZE='01' and PSIZE='01').
+	// Circular mode disabled (CIRC='0').
+	// Read from peripheral (DIR='0').
+	// Memory increment mode enabled (MINC='1').
+	// Transfer complete interrupt enabled (TCIE='1').
+	DMA1 -> CH[0].CCR = (0b01 << 10) | (0b01 << 8) | (0b1 << 7) | (0b1 << 1);
+	// Peripheral address.
+	DMA1 -> CH[0].CPAR = (uint32_t) &(ADC1 -> DR);
+	// Select ADC request (C1S='0000').
+	DMA1 -> CSELR &= ~(0b1111 << 0);
+	// Set interrupt priority.
+	NVIC_set_priority(NVIC_INTERRUPT_DMA1_CHA1, 1);
+	NVIC_enable_interrupt(NVIC_INTERRUPT_DMA1_CHA1);
+}
+
+/* SET DMA1 CHANNEL 1 DESTINATION BUFFER.
+ * @param destination_buffer_address:	Address of the buffer that will contain ADC data.
+ * @param destination_buffer_size:		Number of 16-bits samples to transfer.
+ * @return:								None.
+ * Note: the channel must be stopped before calling this function.
+ */
+void DMA1_CH1_set_destination_address(uint32_t destination_buffer_address, uint16_t destination_buffer_size) {
+	// Set memory address and transfer size.
+	DMA1 -> CH[0].CMAR = destination_buffer_address;
+	DMA1 -> CH[0].CNDTR = destination_buffer_size;
+}
+
+/* START DMA1 CHANNEL 1 TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH1_start(void) {
+	// Clear all flags.
+	dma1_ch1_tc_flag = 0;
+	DMA1 -> IFCR |= (0b1111 << 0); // CGIF1='1', CTCIF1='1', CHTIF1='1' and CTEIF1='1'.
+	// Start transfer.
+	DMA1 -> CH[0].CCR |= (0b1 << 0); // EN='1'.
+}
+
+/* STOP DMA1 CHANNEL 1 TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH1_stop(void) {
+	// Stop transfer.
+	DMA1 -> CH[0].CCR &= ~(0b1 << 0); // EN='0'.
+}
+
+/* GET DMA1 CHANNEL 1 TRANSFER STATUS.
+ * @param:			None.
+ * @return status:	'1' if the transfer is complete, '0' otherwise.
+ */
+volatile uint8_t DMA1_CH1_get_transfer_status(void) {
+	return dma1_ch1_tc_flag;
+}
+
+/* CONFIGURE DMA1 CHANNEL 3 FOR LPUART1 RX CIRCULAR TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH3_init(void) {
+	// Enable peripheral clock.
+	RCC -> AHBENR |= (0b1 << 0); // DMAEN='1'.
+	// Disable channel before configuration.
+	DMA1 -> CH[2].CCR &= ~(0b1 << 0); // EN='0'.
+	// Memory and peripheral data size are 8 bits (MSIZE='00' and PSIZE='00').
+	// Read from peripheral (DIR='0').
+	// Circular mode enabled (CIRC='1').
+	// Memory increment mode enabled (MINC='1').
+	// Half transfer and transfer complete interrupts enabled (HTIE='1' and TCIE='1').
+	DMA1 -> CH[2].CCR = (0b1 << 7) | (0b1 << 5) | (0b1 << 2) | (0b1 << 1);
+	// Peripheral address.
+	DMA1 -> CH[2].CPAR = (uint32_t) &(LPUART1 -> RDR);
+	// Select LPUART1 RX request (C3S='0101').
+	DMA1 -> CSELR &= ~(0b1111 << 8);
+	DMA1 -> CSELR |= (0b0101 << 8);
+	// Same priority as LPUART1 interrupt so that both handlers never preempt each other.
+	NVIC_set_priority(NVIC_INTERRUPT_DMA1_CH_2_3, 0);
+	NVIC_enable_interrupt(NVIC_INTERRUPT_DMA1_CH_2_3);
+}
+
+/* SET DMA1 CHANNEL 3 DESTINATION BUFFER.
+ * @param destination_buffer_address:	Address of the circular buffer that will contain LPUART1 received bytes.
+ * @param destination_buffer_size:		Size of the buffer in bytes.
+ * @return:								None.
+ * Note: the channel must be stopped before calling this function.
+ */
+void DMA1_CH3_set_destination_address(uint32_t destination_buffer_address, uint16_t destination_buffer_size) {
+	// Set memory address and transfer size.
+	DMA1 -> CH[2].CMAR = destination_buffer_address;
+	DMA1 -> CH[2].CNDTR = destination_buffer_size;
+}
+
+/* START DMA1 CHANNEL 3 TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH3_start(void) {
+	// Clear all flags.
+	DMA1 -> IFCR |= (0b1111 << 8); // CGIF3='1', CTCIF3='1', CHTIF3='1' and CTEIF3='1'.
+	// Start transfer.
+	DMA1 -> CH[2].CCR |= (0b1 << 0); // EN='1'.
+}
+
+/* STOP DMA1 CHANNEL 3 TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH3_stop(void) {
+	// Stop transfer.
+	DMA1 -> CH[2].CCR &= ~(0b1 << 0); // EN='0'.
+}
+
+/* GET DMA1 CHANNEL 3 REMAINING TRANSFERS.
+ * @param:	None.
+ * @return:	Number of transfers remaining before the circular buffer wraps.
+ */
+uint16_t DMA1_CH3_get_number_of_remaining_transfers(void) {
+	return (uint16_t) ((DMA1 -> CH[2].CNDTR) & 0xFFFF);
+}
+
+/* CONFIGURE DMA1 CHANNEL 5 FOR USART2 RX CIRCULAR TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH5_init(void) {
+	// Enable peripheral clock.
+	RCC -> AHBENR |= (0b1 << 0); // DMAEN='1'.
+	// Disable channel before configuration.
+	DMA1 -> CH[4].CCR &= ~(0b1 << 0); // EN='0'.
+	// Memory and peripheral data size are 8 bits (MSIZE='00' and PSIZE='00').
+	// Read from peripheral (DIR='0').
+	// Circular mode enabled (CIRC='1').
+	// Memory increment mode enabled (MINC='1').
+	// Half transfer and transfer complete interrupts enabled (HTIE='1' and TCIE='1').
+	DMA1 -> CH[4].CCR = (0b1 << 7) | (0b1 << 5) | (0b1 << 2) | (0b1 << 1);
+	// Peripheral address.
+	DMA1 -> CH[4].CPAR = (uint32_t) &(USART2 -> RDR);
+	// Select USART2 RX request (C5S='0100').
+	DMA1 -> CSELR &= ~(0b1111 << 16);
+	DMA1 -> CSELR |= (0b0100 << 16);
+	// Same priority as USART2 interrupt so that both handlers never preempt each other.
+	NVIC_set_priority(NVIC_INTERRUPT_DMA1_CH_4_7, 3);
+	NVIC_enable_interrupt(NVIC_INTERRUPT_DMA1_CH_4_7);
+}
+
+/* SET DMA1 CHANNEL 5 DESTINATION BUFFER.
+ * @param destination_buffer_address:	Address of the circular buffer that will contain USART2 received bytes.
+ * @param destination_buffer_size:		Size of the buffer in bytes.
+ * @return:								None.
+ * Note: the channel must be stopped before calling this function.
+ */
+void DMA1_CH5_set_destination_address(uint32_t destination_buffer_address, uint16_t destination_buffer_size) {
+	// Set memory address and transfer size.
+	DMA1 -> CH[4].CMAR = destination_buffer_address;
+	DMA1 -> CH[4].CNDTR = destination_buffer_size;
+}
+
+/* START DMA1 CHANNEL 5 TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH5_start(void) {
+	// Clear all flags.
+	DMA1 -> IFCR |= (0b1111 << 16); // CGIF5='1', CTCIF5='1', CHTIF5='1' and CTEIF5='1'.
+	// Start transfer.
+	DMA1 -> CH[4].CCR |= (0b1 << 0); // EN='1'.
+}
+
+/* STOP DMA1 CHANNEL 5 TRANSFER.
+ * @param:	None.
+ * @return:	None.
+ */
+void DMA1_CH5_stop(void) {
+	// Stop transfer.
+	DMA1 -> CH[4].CCR &= ~(0b1 << 0); // EN='0'.
+}
+
+/* GET DMA1 CHANNEL 5 REMAINING TRANSFERS.
+ * @param:	None.
+ * @return:	Number of transfers remaining before the circular buffer wraps.
+ */
+uint16_t DMA1_CH5_get_number_of_remaining_transfers(void) {
+	return (uint16_t) ((DMA1 -> CH[4].CNDTR) & 0xFFFF);
+}
@@ -26,6 +26,7 @@
 
 static uint32_t lptim_clock_frequency_hz = 0;
 static volatile uint8_t lptim_wake_up = 0;
+static uint32_t lptim_timer_arr = 0;
 
 /*** LPTIM local functions ***/
 
@@ -155,3 +156,84 @@ errors:
 	LPTIM1 -> CR &= ~(0b1 << 0); // Disable LPTIM1 (ENABLE='0').
 	return status;
 }
+
+/* START LPTIM AS A ONE-SHOT TIMER.
+ * @param timeout_ms:	Timer duration in ms.
+ * @return status:		Function execution status.
+ * Note: the function is non-blocking, timer expiration is checked with the LPTIM1_get_timer_flag() function.
+ */
+LPTIM_status_t LPTIM1_start_timer(uint32_t timeout_ms) {
+	// Local variables.
+	LPTIM_status_t status = LPTIM_SUCCESS;
+	// Check duration.
+	if ((timeout_ms > LPTIM_DELAY_MS_MAX) || (timeout_ms > (IWDG_REFRESH_PERIOD_SECONDS * 1000))) {
+		status = LPTIM_ERROR_DELAY_OVERFLOW;
+		goto errors;
+	}
+	if (timeout_ms < LPTIM_DELAY_MS_MIN) {
+		status = LPTIM_ERROR_DELAY_UNDERFLOW;
+		goto errors;
+	}
+	// Stop previous timer if needed.
+	LPTIM1_stop_timer();
+	// Enable timer.
+	LPTIM1 -> CR |= (0b1 << 0); // Enable LPTIM1 (ENABLE='1').
+	// Reset counter and flags.
+	LPTIM1 -> CNT &= 0xFFFF0000;
+	LPTIM1 -> ICR |= (0b1111111 << 0);
+	// Compute ARR value.
+	lptim_timer_arr = ((timeout_ms * lptim_clock_frequency_hz) / (1000)) & 0x0000FFFF;
+	status = _LPTIM1_write_arr(lptim_timer_arr);
+	if (status != LPTIM_SUCCESS) goto errors;
+	// Enable interrupt.
+	lptim_wake_up = 0;
+	NVIC_enable_interrupt(NVIC_INTERRUPT_LPTIM1);
+	// Start timer.
+	LPTIM1 -> CR |= (0b1 << 1); // SNGSTRT='1'.
+	return status;
+errors:
+	// Disable timer.
+	LPTIM1 -> CR &= ~(0b1 << 0); // Disable LPTIM1 (ENABLE='0').
+	return status;
+}
+
+/* STOP LPTIM ONE-SHOT TIMER.
+ * @param:	None.
+ * @return:	None.
+ */
+void LPTIM1_stop_timer(void) {
+	// Disable interrupt and timer.
+	NVIC_disable_interrupt(NVIC_INTERRUPT_LPTIM1);
+	LPTIM1 -> CR &= ~(0b1 << 0); // Disable LPTIM1 (ENABLE='0').
+}
+
+/* GET LPTIM ONE-SHOT TIMER EXPIRATION FLAG.
+ * @param:	None.
+ * @return:	1 if the timer started with LPTIM1_start_timer() has expired, 0 otherwise.
+ */
+uint8_t LPTIM1_get_timer_flag(void) {
+	return lptim_wake_up;
+}
+
+/* GET TIME ELAPSED SINCE LPTIM ONE-SHOT TIMER START.
+ * @param:	None.
+ * @return:	Elapsed time in ms.
+ */
+uint32_t LPTIM1_get_timer_elapsed_ms(void) {
+	// Local variables.
+	uint32_t cnt = 0;
+	uint32_t cnt_check = 0;
+	// Timer has been stopped by hardware on expiration.
+	if (lptim_wake_up != 0) {
+		cnt = lptim_timer_arr;
+	}
+	else {
+		// Counter is asynchronous: read it until two consecutive values are equal.
+		do {
+			cnt = (LPTIM1 -> CNT) & 0x0000FFFF;
+			cnt_check = (LPTIM1 -> CNT) & 0x0000FFFF;
+		}
+		while (cnt != cnt_check);
+	}
+	return ((cnt * 1000) / (lptim_clock_frequency_hz));
+}
@@ -7,21 +7,30 @@
 
 #include "lpuart.h"
 
+#include "dma.h"
 #include "exti.h"
 #include "gpio.h"
 #include "lpuart_reg.h"
 #include "mapping.h"
 #include "nvic.h"
+#include "prof.h"
+#include "pwr.h"
 #include "rcc.h"
 #include "rcc_reg.h"
 #include "rs485.h"
 #include "rs485_common.h"
+#include "string.h"
 
 /*** LPUART local macros ***/
 
-#define LPUART_BAUD_RATE 		9600
+#define LPUART_BAUD_RATE_DEFAULT	9600
+#define LPUART_BAUD_RATE_LSE_MAX	9600
+#define LPUART_BRR_MIN				0x00300
+#define LPUART_BRR_MAX				0xFFFFF
 #define LPUART_STRING_SIZE_MAX	1000
 #define LPUART_TIMEOUT_COUNT	100000
+#define LPUART_TX_BUFFER_SIZE	128 // Must be a power of 2.
+#define LPUART_RX_BUFFER_SIZE	128 // Must be a power of 2.
 //#define LPUART_USE_NRE
 
 /*** LPUART local structures ***/
@@ -29,10 +38,21 @@
 typedef struct {
 	RS485_address_t node_address;
 	RS485_mode_t mode;
+	// TX ring buffer.
+	volatile uint8_t tx_buffer[LPUART_TX_BUFFER_SIZE];
+	volatile uint32_t tx_write_idx;
+	volatile uint32_t tx_read_idx;
+	volatile uint8_t tx_running;
+	uint32_t baud_rate;
+	// RX circular buffer (filled by DMA).
+	volatile uint8_t rx_buffer[LPUART_RX_BUFFER_SIZE];
+	volatile uint32_t rx_read_idx;
+	volatile uint32_t rx_overruns;
 } LPUART_context_t;
 
 /*** LPUART local global variables ***/
 
+static const uint32_t LPUART_BAUD_RATE_LIST[] = {1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600};
 static LPUART_context_t lpuart_ctx;
 
 /*** LPUART local functions ***/
@@ -42,21 +62,55 @@ static LPUART_context_t lpuart_ctx;
  * @return:	None.
  */
 void LPUART1_IRQHandler(void) {
-	// Local variables.
-	uint8_t rx_byte = 0;
-	// RXNE interrupt.
-	if (((LPUART1 -> ISR) & (0b1 << 5)) != 0) {
-		// Read incoming byte.
-		rx_byte = (LPUART1 -> RDR);
-		RS485_fill_rx_buffer(rx_byte);
-		// Clear RXNE flag.
-		LPUART1 -> RQR |= (0b1 << 3);
+	PROF_enter(PROF_PROBE_LPUART1_IRQ);
+	// Character match interrupt (end of frame in direct mode).
+	if ((((LPUART1 -> CR1) & (0b1 << 14)) != 0) && (((LPUART1 -> ISR) & (0b1 << 17)) != 0)) {
+		// Clear flag and process received bytes.
+		LPUART1 -> ICR |= (0b1 << 17);
+		LPUART1_process_rx_dma();
+	}
+	// Idle line interrupt (end of frame in both modes).
+	if ((((LPUART1 -> CR1) & (0b1 << 4)) != 0) && (((LPUART1 -> ISR) & (0b1 << 4)) != 0)) {
+		// Clear flag and process received bytes.
+		LPUART1 -> ICR |= (0b1 << 4);
+		LPUART1_process_rx_dma();
+	}
+	// TXE interrupt.
+	if ((((LPUART1 -> CR1) & (0b1 << 7)) != 0) && (((LPUART1 -> ISR) & (0b1 << 7)) != 0)) {
+		// Check if there are remaining bytes to send.
+		if (lpuart_ctx.tx_read_idx != lpuart_ctx.tx_write_idx) {
+			// Fill transmit register.
+			LPUART1 -> TDR = lpuart_ctx.tx_buffer[lpuart_ctx.tx_read_idx];
+			lpuart_ctx.tx_read_idx = (lpuart_ctx.tx_read_idx + 1) & (LPUART_TX_BUFFER_SIZE - 1);
+		}
+		else {
+			// Buffer empty: wait for the last byte to be shifted out.
+			LPUART1 -> CR1 &= ~(0b1 << 7); // TXEIE='0'.
+			LPUART1 -> CR1 |= (0b1 << 6); // TCIE='1'.
+		}
+	}
+	// TC interrupt.
+	if ((((LPUART1 -> CR1) & (0b1 << 6)) != 0) && (((LPUART1 -> ISR) & (0b1 << 6)) != 0)) {
+		// Disable interrupt and clear flag.
+		LPUART1 -> CR1 &= ~(0b1 << 6); // TCIE='0'.
+		LPUART1 -> ICR |= (0b1 << 6);
+		// Update status and notify upper layer.
+		lpuart_ctx.tx_running = 0;
+		RS485_tx_complete();
 	}
-	// Overrun error interrupt.
+	// Wake-up interrupt (RX data is handled by DMA once the core is running).
+	if ((((LPUART1 -> CR3) & (0b1 << 22)) != 0) && (((LPUART1 -> ISR) & (0b1 << 20)) != 0)) {
+		// Clear flag.
+		LPUART1 -> ICR |= (0b1 << 20);
+	}
+	// Error interrupt.
 	if (((LPUART1 -> ISR) & (0b1 << 3)) != 0) {
-		// Clear ORE flag.
-		LPUART1 -> ICR |= (0b1 << 3);
+		// Count lost bytes.
+		lpuart_ctx.rx_overruns++;
 	}
+	// Clear ORE, NF and FE flags.
+	LPUART1 -> ICR |= (0b111 << 1);
+	PROF_exit(PROF_PROBE_LPUART1_IRQ);
 }
 
 /* FILL LPUART1 TX BUFFER WITH A NEW BYTE.
@@ -66,18 +120,15 @@ void LPUART1_IRQHandler(void) {
 static LPUART_status_t _LPUART1_fill_tx_buffer(uint8_t tx_byte) {
 	// Local variables.
 	LPUART_status_t status = LPUART_SUCCESS;
-	uint32_t loop_count = 0;
-	// Fill transmit register.
-	LPUART1 -> TDR = tx_byte;
-	// Wait for transmission to complete.
-	while (((LPUART1 -> ISR) & (0b1 << 7)) == 0) {
-		// Wait for TXE='1' or timeout.
-		loop_count++;
-		if (loop_count > LPUART_TIMEOUT_COUNT) {
-			status = LPUART_ERROR_TX_TIMEOUT;
-			goto errors;
-		}
+	uint32_t next_write_idx = (lpuart_ctx.tx_write_idx + 1) & (LPUART_TX_BUFFER_SIZE - 1);
+	// Check free space.
+	if (next_write_idx == lpuart_ctx.tx_read_idx) {
+		status = LPUART_ERROR_TX_BUFFER_FULL;
+		goto errors;
 	}
+	// Append byte.
+	lpuart_ctx.tx_buffer[lpuart_ctx.tx_write_idx] = tx_byte;
+	lpuart_ctx.tx_write_idx = next_write_idx;
 errors:
 	return status;
 }
@@ -100,6 +151,12 @@ LPUART_status_t LPUART1_init(RS485_address_t node_address) {
 	// Init context.
 	lpuart_ctx.node_address = (node_address & RS485_ADDRESS_MASK);
 	lpuart_ctx.mode = RS485_MODE_DIRECT;
+	lpuart_ctx.tx_write_idx = 0;
+	lpuart_ctx.tx_read_idx = 0;
+	lpuart_ctx.tx_running = 0;
+	lpuart_ctx.rx_read_idx = 0;
+	lpuart_ctx.rx_overruns = 0;
+	lpuart_ctx.baud_rate = LPUART_BAUD_RATE_DEFAULT;
 	// Select LSE as clock source.
 	RCC -> CCIPR |= (0b11 << 10); // LPUART1SEL='11'.
 	// Enable peripheral clock.
@@ -116,14 +173,21 @@ LPUART_status_t LPUART1_init(RS485_address_t node_address) {
 	// Put NRE pin in high impedance since it is directly connected to the DE pin.
 	GPIO_configure(&GPIO_LPUART1_NRE, GPIO_MODE_ANALOG, GPIO_TYPE_OPEN_DRAIN, GPIO_SPEED_LOW, GPIO_PULL_NONE);
 #endif
-	// Configure peripheral in direct mode by default.
-	LPUART1 -> CR1 |= 0x00000022;
-	LPUART1 -> CR2 |= ((lpuart_ctx.node_address & 0x7F) << 24) | (0b1 << 4);
-	LPUART1 -> CR3 |= 0x00B05000;
+	// Configure peripheral in direct mode by default (frame end character match and idle line interrupts, RX data handled by DMA).
+	// Note: UESM is only set before entering stop mode (see LPUART1_enable_wake_up() function).
+	LPUART1 -> CR1 |= 0x00004010;
+	LPUART1 -> CR2 |= (RS485_FRAME_END << 24) | (0b1 << 4);
+	LPUART1 -> CR3 |= (0b1 << 23) | (0b11 << 20) | (0b1 << 14); // Clock enable in stop mode (UCESM='1'), wake-up on RXNE in direct mode (WUS='11', see LPUART1_set_mode()) and driver enable (DEM='1').
+	LPUART1 -> CR3 |= (0b1 << 6) | (0b1 << 0); // Reception handled by DMA (DMAR='1') and error interrupt enabled to count overruns (EIE='1' and OVRDIS='0').
 	// Baud rate.
 	brr = (RCC_LSE_FREQUENCY_HZ * 256);
-	brr /= LPUART_BAUD_RATE;
+	brr /= LPUART_BAUD_RATE_DEFAULT;
 	LPUART1 -> BRR = (brr & 0x000FFFFF); // BRR = (256*fCK)/(baud rate). See p.730 of RM0377 datasheet.
+	// Start circular reception.
+	DMA1_CH3_init();
+	DMA1_CH3_stop();
+	DMA1_CH3_set_destination_address((uint32_t) lpuart_ctx.rx_buffer, LPUART_RX_BUFFER_SIZE);
+	DMA1_CH3_start();
 	// Configure interrupt.
 	NVIC_set_priority(NVIC_INTERRUPT_LPUART1, 0);
 	EXTI_configure_line(EXTI_LINE_LPUART1, EXTI_TRIGGER_RISING_EDGE);
@@ -141,6 +205,17 @@ LPUART_status_t LPUART1_init(RS485_address_t node_address) {
 LPUART_status_t LPUART1_set_mode(RS485_mode_t mode) {
 	// Local variables.
 	LPUART_status_t status = LPUART_SUCCESS;
+	uint32_t loop_count = 0;
+	// Wait for pending transmission to complete.
+	while (lpuart_ctx.tx_running != 0) {
+		// Wait for TC interrupt or timeout.
+		PWR_enter_sleep_mode();
+		loop_count++;
+		if (loop_count > LPUART_TIMEOUT_COUNT) {
+			status = LPUART_ERROR_TC_TIMEOUT;
+			goto errors;
+		}
+	}
 	// Disable peripheral.
 	LPUART1 -> CR1 &= ~(0b1 << 0);
 	// Configure peripheral.
@@ -148,12 +223,20 @@ LPUART_status_t LPUART1_set_mode(RS485_mode_t mode) {
 	case RS485_MODE_DIRECT:
 		// Disable mute mode, address detection and wake-up on RXNE.
 		LPUART1 -> CR1 &= 0xFFFFD7FF; // MME='0' and WAKE='0'.
-		LPUART1 -> CR3 |= 0x00030000; // WUS='11'.
+		LPUART1 -> CR3 |= 0x00300000; // WUS='11'.
+		// Use address field for frame end character match.
+		LPUART1 -> CR2 &= 0x00FFFFFF;
+		LPUART1 -> CR2 |= (RS485_FRAME_END << 24);
+		LPUART1 -> CR1 |= (0b1 << 14); // CMIE='1'.
 		break;
 	case RS485_MODE_ADDRESSED:
 		// Enable mute mode, address detection and wake up on address match.
 		LPUART1 -> CR1 |= 0x00002800; // MME='1' and WAKE='1'.
 		LPUART1 -> CR3 &= 0xFFCFFFFF; // WUS='00'.
+		// Address field is used for node address detection: frame end is detected on idle line only.
+		LPUART1 -> CR2 &= 0x00FFFFFF;
+		LPUART1 -> CR2 |= ((lpuart_ctx.node_address & 0x7F) << 24);
+		LPUART1 -> CR1 &= ~(0b1 << 14); // CMIE='0'.
 		break;
 	default:
 		status = LPUART_ERROR_MODE;
@@ -167,6 +250,72 @@ errors:
 	return status;
 }
 
+/* CONFIGURE LPUART BAUD RATE.
+ * @param baud_rate:	Baud rate (must be one of the standard values).
+ * @return status:		Function execution status.
+ * Note: LSE is used as kernel clock up to 9600 bauds to keep wake-up from stop mode at minimum consumption, HSI16 is used above.
+ */
+LPUART_status_t LPUART1_set_baud_rate(uint32_t baud_rate) {
+	// Local variables.
+	LPUART_status_t status = LPUART_SUCCESS;
+	uint32_t brr = 0;
+	uint32_t loop_count = 0;
+	uint8_t idx = 0;
+	// Check parameter.
+	status = LPUART_ERROR_BAUD_RATE;
+	for (idx=0 ; idx<(sizeof(LPUART_BAUD_RATE_LIST) / sizeof(uint32_t)) ; idx++) {
+		if (LPUART_BAUD_RATE_LIST[idx] == baud_rate) {
+			status = LPUART_SUCCESS;
+			break;
+		}
+	}
+	if (status != LPUART_SUCCESS) goto errors;
+	// Compute BRR = (256*fCK)/(baud rate). See p.730 of RM0377 datasheet.
+	if (baud_rate <= LPUART_BAUD_RATE_LSE_MAX) {
+		brr = (RCC_LSE_FREQUENCY_HZ * 256) / baud_rate;
+	}
+	else {
+		brr = (((uint32_t) RCC_HSI_FREQUENCY_KHZ) * 256000) / baud_rate;
+	}
+	if ((brr < LPUART_BRR_MIN) || (brr > LPUART_BRR_MAX)) {
+		status = LPUART_ERROR_BAUD_RATE;
+		goto errors;
+	}
+	// Wait for pending transmission to complete.
+	while (lpuart_ctx.tx_running != 0) {
+		// Wait for TC interrupt or timeout.
+		PWR_enter_sleep_mode();
+		loop_count++;
+		if (loop_count > LPUART_TIMEOUT_COUNT) {
+			status = LPUART_ERROR_TC_TIMEOUT;
+			goto errors;
+		}
+	}
+	// Disable peripheral.
+	LPUART1 -> CR1 &= ~(0b1 << 0); // UE='0'.
+	// Select kernel clock.
+	RCC -> CCIPR &= ~(0b11 << 10);
+	if (baud_rate <= LPUART_BAUD_RATE_LSE_MAX) {
+		RCC -> CCIPR |= (0b11 << 10); // LPUART1SEL='11'.
+		// Release HSI16 in stop mode unless it is still the USART2 kernel clock (USART2SEL='10').
+		if (((RCC -> CCIPR) & (0b11 << 2)) != (0b10 << 2)) {
+			RCC -> CR &= ~(0b1 << 1); // HSI16KERON='0'.
+		}
+	}
+	else {
+		// Keep HSI16 running in stop mode so that the LPUART can still wake-up the MCU.
+		RCC -> CR |= (0b1 << 1); // HSI16KERON='1'.
+		RCC -> CCIPR |= (0b10 << 10); // LPUART1SEL='10'.
+	}
+	// Update baud rate.
+	LPUART1 -> BRR = (brr & LPUART_BRR_MAX);
+	lpuart_ctx.baud_rate = baud_rate;
+	// Enable peripheral.
+	LPUART1 -> CR1 |= (0b1 << 0); // UE='1'.
+errors:
+	return status;
+}
+
 /* EANABLE LPUART RX OPERATION.
  * @param:	None.
  * @return:	None.
@@ -176,8 +325,10 @@ void LPUART1_enable_rx(void) {
 	if (lpuart_ctx.mode == RS485_MODE_ADDRESSED) {
 		LPUART1 -> RQR |= (0b1 << 2); // MMRQ='1'.
 	}
-	// Clear flag and enable interrupt.
-	LPUART1 -> RQR |= (0b1 << 3);
+	// Discard bytes received while RX was disabled.
+	lpuart_ctx.rx_read_idx = (LPUART_RX_BUFFER_SIZE - DMA1_CH3_get_number_of_remaining_transfers()) & (LPUART_RX_BUFFER_SIZE - 1);
+	// Clear flags and enable interrupt.
+	LPUART1 -> ICR |= (0b1 << 17) | (0b1 << 4); // CMCF='1' and IDLECF='1'.
 	NVIC_enable_interrupt(NVIC_INTERRUPT_LPUART1);
 	// Enable receiver.
 	LPUART1 -> CR1 |= (0b1 << 2); // RE='1'.
@@ -198,19 +349,25 @@ void LPUART1_disable_rx(void) {
 #endif
 	// Disable receiver.
 	LPUART1 -> CR1 &= ~(0b1 << 2); // RE='0'.
-	// Disable interrupt.
-	NVIC_disable_interrupt(NVIC_INTERRUPT_LPUART1);
+	// Disable interrupt (only if no transmission is running).
+	if (lpuart_ctx.tx_running == 0) {
+		NVIC_disable_interrupt(NVIC_INTERRUPT_LPUART1);
+	}
 }
 
 /* SEND A COMMAND TO AN RS485 NODE.
  * @param slave_address:	RS485 address of the destination board.
  * @param command:			Command to send.
- * @return:					None.
+ * @return status:			Function execution status.
+ * Note: this function only fills the TX buffer, bytes are sent under interrupt and RS485_tx_complete() is called when the frame is on the wire.
+ * The whole frame is queued or nothing is, so that a truncated frame is never sent on the bus.
  */
 LPUART_status_t LPUART1_send_command(RS485_address_t slave_address, char_t* command) {
 	// Local variables.
 	LPUART_status_t status = LPUART_SUCCESS;
-	uint32_t loop_count = 0;
+	uint32_t frame_size = 0;
+	uint32_t free_space = 0;
+	uint32_t idx = 0;
 	// Check parameters.
 	if (command == NULL) {
 		status = LPUART_ERROR_NULL_PARAMETER;
@@ -220,6 +377,24 @@ LPUART_status_t LPUART1_send_command(RS485_address_t slave_address, char_t* comm
 		status = LPUART_ERROR_NODE_ADDRESS;
 		goto errors;
 	}
+	// Compute frame size.
+	while (command[frame_size] != STRING_CHAR_NULL) {
+		frame_size++;
+		// Check character count.
+		if (frame_size > LPUART_STRING_SIZE_MAX) {
+			status = LPUART_ERROR_STRING_SIZE;
+			goto errors;
+		}
+	}
+	if (lpuart_ctx.mode == RS485_MODE_ADDRESSED) {
+		frame_size += (2 * RS485_ADDRESS_SIZE_BYTES);
+	}
+	// Check free space (read index can only move forward under interrupt, so this is a lower bound).
+	free_space = (lpuart_ctx.tx_read_idx - lpuart_ctx.tx_write_idx - 1) & (LPUART_TX_BUFFER_SIZE - 1);
+	if (frame_size > free_space) {
+		status = LPUART_ERROR_TX_BUFFER_FULL;
+		goto errors;
+	}
 	// Send header if required.
 	if (lpuart_ctx.mode == RS485_MODE_ADDRESSED) {
 		// Send destination and source addresses.
@@ -229,28 +404,99 @@ LPUART_status_t LPUART1_send_command(RS485_address_t slave_address, char_t* comm
 		if (status != LPUART_SUCCESS) goto errors;
 	}
 	// Fill TX buffer with new bytes.
-	while (*command) {
-		status = _LPUART1_fill_tx_buffer((uint8_t) *(command++));
+	for (idx=0 ; command[idx] != STRING_CHAR_NULL ; idx++) {
+		status = _LPUART1_fill_tx_buffer((uint8_t) command[idx]);
 		if (status != LPUART_SUCCESS) goto errors;
-		// Check character count.
-		loop_count++;
-		if (loop_count > LPUART_STRING_SIZE_MAX) {
-			status = LPUART_ERROR_STRING_SIZE;
-			goto errors;
-		}
-	}
-#ifdef LPUART_USE_NRE
-	// Wait for TC flag (to avoid echo when enabling RX again).
-	loop_count = 0;
-	while (((LPUART1 -> ISR) & (0b1 << 6)) == 0) {
-		// Exit if timeout.
-		loop_count++;
-		if (loop_count > LPUART_TIMEOUT_COUNT) {
-			status = LPUART_ERROR_TC_TIMEOUT;
-			goto errors;
-		}
 	}
-#endif
+	// Start transmission (disable interrupt during update).
+	NVIC_disable_interrupt(NVIC_INTERRUPT_LPUART1);
+	lpuart_ctx.tx_running = 1;
+	LPUART1 -> CR1 &= ~(0b1 << 6); // TCIE='0'.
+	LPUART1 -> CR1 |= (0b1 << 7); // TXEIE='1'.
+	NVIC_enable_interrupt(NVIC_INTERRUPT_LPUART1);
 errors:
 	return status;
 }
+
+/* FORWARD BYTES RECEIVED BY DMA TO THE RS485 LAYER (CALLED BY LPUART AND DMA INTERRUPTS).
+ * @param:	None.
+ * @return:	None.
+ */
+void LPUART1_process_rx_dma(void) {
+	// Local variables.
+	uint32_t write_idx = (LPUART_RX_BUFFER_SIZE - DMA1_CH3_get_number_of_remaining_transfers()) & (LPUART_RX_BUFFER_SIZE - 1);
+	// Bytes loop.
+	while (lpuart_ctx.rx_read_idx != write_idx) {
+		RS485_fill_rx_buffer(lpuart_ctx.rx_buffer[lpuart_ctx.rx_read_idx]);
+		lpuart_ctx.rx_read_idx = (lpuart_ctx.rx_read_idx + 1) & (LPUART_RX_BUFFER_SIZE - 1);
+	}
+}
+
+/* ENABLE LPUART WAKE-UP FROM STOP MODE.
+ * @param:	None.
+ * @return:	None.
+ * Note: the wake-up event is the address match in addressed mode and RXNE in direct mode (WUS field).
+ */
+void LPUART1_enable_wake_up(void) {
+	// Clear flag and enable wake-up interrupt.
+	LPUART1 -> ICR |= (0b1 << 20); // WUCF='1'.
+	LPUART1 -> CR3 |= (0b1 << 22); // WUFIE='1'.
+	LPUART1 -> CR1 |= (0b1 << 1); // UESM='1'.
+}
+
+/* DISABLE LPUART WAKE-UP FROM STOP MODE.
+ * @param:	None.
+ * @return:	None.
+ */
+void LPUART1_disable_wake_up(void) {
+	// Disable wake-up interrupt.
+	LPUART1 -> CR1 &= ~(0b1 << 1); // UESM='0'.
+	LPUART1 -> CR3 &= ~(0b1 << 22); // WUFIE='0'.
+}
+
+/* CHECK IF LPUART CAN BE STOPPED.
+ * @param:	None.
+ * @return:	1 if there is no transmission, reception or unprocessed RX data, 0 otherwise.
+ */
+uint8_t LPUART1_is_idle(void) {
+	// Local variables.
+	uint8_t idle = 0;
+	uint32_t write_idx = (LPUART_RX_BUFFER_SIZE - DMA1_CH3_get_number_of_remaining_transfers()) & (LPUART_RX_BUFFER_SIZE - 1);
+	// Check status.
+	if ((lpuart_ctx.tx_running == 0) && (((LPUART1 -> ISR) & (0b1 << 16)) == 0) && (lpuart_ctx.rx_read_idx == write_idx)) {
+		idle = 1;
+	}
+	return idle;
+}
+
+/* GET LPUART TRANSMISSION STATUS.
+ * @param:	None.
+ * @return:	1 if a frame is currently being sent, 0 otherwise.
+ */
+uint8_t LPUART1_is_tx_running(void) {
+	return lpuart_ctx.tx_running;
+}
+
+/* GET LPUART BAUD RATE.
+ * @param:	None.
+ * @return:	Current baud rate.
+ */
+uint32_t LPUART1_get_baud_rate(void) {
+	return lpuart_ctx.baud_rate;
+}
+
+/* GET LPUART RX OVERRUNS COUNT.
+ * @param:	None.
+ * @return:	Number of overrun errors since last reset.
+ */
+uint32_t LPUART1_get_rx_overruns(void) {
+	return lpuart_ctx.rx_overruns;
+}
+
+/* RESET LPUART RX OVERRUNS COUNT.
+ * @param:	None.
+ * @return:	None.
+ */
+void LPUART1_reset_rx_overruns(void) {
+	lpuart_ctx.rx_overruns = 0;
+}
@@ -139,3 +139,47 @@ NVM_status_t NVM_write_byte(NVM_address_t address_offset, uint8_t data) {
 errors:
 	return status;
 }
+
+/* READ A 32-BITS VALUE STORED IN NVM.
+ * @param address_offset:	Address offset of the first byte starting from NVM start address (expressed in bytes).
+ * @param data:				Pointer to 32-bits value that will contain the value to read (stored LSB first).
+ * @return status:			Function execution status.
+ */
+NVM_status_t NVM_read_word(NVM_address_t address_offset, uint32_t* data) {
+	// Local variables.
+	NVM_status_t status = NVM_SUCCESS;
+	uint8_t nvm_byte = 0;
+	uint8_t idx = 0;
+	// Check parameter.
+	if (data == NULL) {
+		status = NVM_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	// Read bytes.
+	(*data) = 0;
+	for (idx=0 ; idx<4 ; idx++) {
+		status = NVM_read_byte((address_offset + idx), &nvm_byte);
+		if (status != NVM_SUCCESS) goto errors;
+		(*data) |= (((uint32_t) nvm_byte) << (8 * idx));
+	}
+errors:
+	return status;
+}
+
+/* WRITE A 32-BITS VALUE TO NVM.
+ * @param address_offset:	Address offset of the first byte starting from NVM start address (expressed in bytes).
+ * @param data:				32-bits value to store in NVM (LSB first).
+ * @return status:			Function execution status.
+ */
+NVM_status_t NVM_write_word(NVM_address_t address_offset, uint32_t data) {
+	// Local variables.
+	NVM_status_t status = NVM_SUCCESS;
+	uint8_t idx = 0;
+	// Write bytes.
+	for (idx=0 ; idx<4 ; idx++) {
+		status = NVM_write_byte((address_offset + idx), (uint8_t) (data >> (8 * idx)));
+		if (status != NVM_SUCCESS) goto errors;
+	}
+errors:
+	return status;
+}
@@ -7,13 +7,49 @@
 
 #include "pwr.h"
 
-#include "exti_reg.h"
 #include "flash_reg.h"
-#include "nvic_reg.h"
+#include "mode.h"
 #include "pwr_reg.h"
 #include "rcc_reg.h"
-#include "rtc_reg.h"
+#include "rtc.h"
 #include "scb_reg.h"
+#include "types.h"
+
+#ifdef PWR_STATISTICS
+
+/*** PWR local structures ***/
+
+typedef struct {
+	uint32_t state_time_ms[PWR_STATE_LAST];
+	uint32_t last_wake_up_time_ms;
+	uint32_t low_power_entry_time_ms;
+} PWR_statistics_t;
+
+/*** PWR local global variables ***/
+
+static PWR_statistics_t pwr_statistics;
+
+/*** PWR local functions ***/
+
+/* UPDATE STATISTICS BEFORE ENTERING A LOW POWER MODE.
+ * @param:	None.
+ * @return:	None.
+ */
+static void _PWR_enter_low_power_mode(void) {
+	pwr_statistics.low_power_entry_time_ms = RTC_get_time_ms();
+	pwr_statistics.state_time_ms[PWR_STATE_RUN] += RTC_get_duration_ms(pwr_statistics.last_wake_up_time_ms, pwr_statistics.low_power_entry_time_ms);
+}
+
+/* UPDATE STATISTICS AFTER EXITING A LOW POWER MODE.
+ * @param state:	Low power state which has just been exited.
+ * @return:			None.
+ */
+static void _PWR_exit_low_power_mode(PWR_state_t state) {
+	pwr_statistics.last_wake_up_time_ms = RTC_get_time_ms();
+	pwr_statistics.state_time_ms[state] += RTC_get_duration_ms(pwr_statistics.low_power_entry_time_ms, pwr_statistics.last_wake_up_time_ms);
+}
+
+#endif
 
 /*** PWR functions ***/
 
@@ -47,12 +83,20 @@ void PWR_enter_sleep_mode(void) {
 	PWR -> CR &= ~(0b1 << 0); // LPSDSR='0'.
 	// Enter low power sleep mode.
 	SCB -> SCR &= ~(0b1 << 2); // SLEEPDEEP='0'.
+#ifdef PWR_STATISTICS
+	_PWR_enter_low_power_mode();
+#endif
 	__asm volatile ("wfi"); // Wait For Interrupt core instruction.
+#ifdef PWR_STATISTICS
+	_PWR_exit_low_power_mode(PWR_STATE_SLEEP);
+#endif
 }
 
 /* FUNCTION TO ENTER STOP MODE.
  * @param:	None.
  * @return:	None.
+ * Note: pending interrupts are not cleared, so that the core immediately exits stop mode if a wake-up event occurred before WFI.
+ * Only EXTI lines (GPIO, RTC, LPTIM and U(S)ART wake-up) can exit stop mode: caller must ensure no other peripheral is running.
  */
 void PWR_enter_stop_mode(void) {
 	// Regulator in low power mode.
@@ -61,17 +105,17 @@ void PWR_enter_stop_mode(void) {
 	PWR -> CR |= (0b1 << 2); // CWUF='1'.
 	// Enter stop mode when CPU enters deepsleep.
 	PWR -> CR &= ~(0b1 << 1); // PDDS='0'.
-	// Clear all EXTI, RTC and peripherals interrupt pending bits.
-	RCC -> CICR |= 0x000001BF;
-	EXTI -> PR |= 0x007BFFFF; // PIFx='1'.
-	RTC -> ISR &= 0xFFFE035F; // Reset wake-up, tamper and timestamp flags.
-	// Note: RTC alarms flags are not cleared because alarm A flag is read statically after wake-up in the main.
-	// If the alarm A or B flag is set when entering stop mode, the execution will be ignored but the main will directly treat and clear the flag.
-	// The MCU will enter stop on the second loop.
-	NVIC -> ICPR = 0xFFFFFFFF; // CLEARPENDx='1'.
 	// Enter stop mode.
 	SCB -> SCR |= (0b1 << 2); // SLEEPDEEP='1'.
+#ifdef PWR_STATISTICS
+	_PWR_enter_low_power_mode();
+#endif
 	__asm volatile ("wfi"); // Wait For Interrupt core instruction.
+	// Back to sleep mode by default.
+	SCB -> SCR &= ~(0b1 << 2); // SLEEPDEEP='0'.
+#ifdef PWR_STATISTICS
+	_PWR_exit_low_power_mode(PWR_STATE_STOP);
+#endif
 }
 
 /* FUNCTION TO FORCE A SOFTWARE RESET.
@@ -82,3 +126,39 @@ void PWR_software_reset(void) {
 	// Trigger software reset.
 	SCB -> AIRCR = 0x05FA0000 | ((SCB -> AIRCR) & 0x0000FFFF) | (0b1 << 2);
 }
+
+#ifdef PWR_STATISTICS
+/* RESET POWER STATES STATISTICS.
+ * @param:	None.
+ * @return:	None.
+ * Note: RTC must be running.
+ */
+void PWR_reset_statistics(void) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Reset counters.
+	for (idx=0 ; idx<PWR_STATE_LAST ; idx++) {
+		pwr_statistics.state_time_ms[idx] = 0;
+	}
+	pwr_statistics.last_wake_up_time_ms = RTC_get_time_ms();
+	pwr_statistics.low_power_entry_time_ms = pwr_statistics.last_wake_up_time_ms;
+}
+
+/* GET TIME SPENT IN A POWER STATE.
+ * @param state:	Power state.
+ * @return:			Time spent in the given state since last reset (in ms).
+ */
+uint32_t PWR_get_state_time_ms(PWR_state_t state) {
+	// Local variables.
+	uint32_t state_time_ms = 0;
+	// Check parameter.
+	if (state >= PWR_STATE_LAST) goto errors;
+	state_time_ms = pwr_statistics.state_time_ms[state];
+	// Add current run period.
+	if (state == PWR_STATE_RUN) {
+		state_time_ms += RTC_get_duration_ms(pwr_statistics.last_wake_up_time_ms, RTC_get_time_ms());
+	}
+errors:
+	return state_time_ms;
+}
+#endif
@@ -7,6 +7,7 @@
 
 #include "rtc.h"
 
+#include "event.h"
 #include "exti.h"
 #include "exti_reg.h"
 #include "nvic.h"
@@ -18,13 +19,24 @@
 
 #define RTC_INIT_TIMEOUT_COUNT		1000
 #define RTC_WAKEUP_TIMER_DELAY_MAX	65536
-
-/*** RTC local global variables ***/
-
-static volatile uint8_t rtc_wakeup_timer_flag = 0;
+#define RTC_DAY_MS					86400000
 
 /*** RTC local functions ***/
 
+/* CONVERT BCD TIME REGISTER TO SECONDS.
+ * @param tr:	RTC_TR register value.
+ * @return:		Time of day in seconds.
+ */
+static uint32_t _RTC_get_seconds(uint32_t tr) {
+	// Local variables.
+	uint32_t time_s = 0;
+	// Convert BCD time to seconds.
+	time_s += ((((tr >> 20) & 0x3) * 10) + ((tr >> 16) & 0xF)) * 3600;
+	time_s += ((((tr >> 12) & 0x7) * 10) + ((tr >> 8) & 0xF)) * 60;
+	time_s += ((((tr >> 4) & 0x7) * 10) + ((tr >> 0) & 0xF));
+	return time_s;
+}
+
 /* RTC INTERRUPT HANDLER.
  * @param:	None.
  * @return:	None.
@@ -32,9 +44,9 @@ static volatile uint8_t rtc_wakeup_timer_flag = 0;
 void __attribute__((optimize("-O0"))) RTC_IRQHandler(void) {
 	// Wake-up timer interrupt.
 	if (((RTC -> ISR) & (0b1 << 10)) != 0) {
-		// Set local flag.
+		// Notify main loop.
 		if (((RTC -> CR) & (0b1 << 14)) != 0) {
-			rtc_wakeup_timer_flag = 1;
+			EVENT_post(EVENT_RTC_WAKEUP);
 		}
 		// Clear flags.
 		RTC -> ISR &= ~(0b1 << 10); // WUTF='0'.
@@ -208,14 +220,6 @@ errors:
 	return status;
 }
 
-/* RETURN THE CURRENT ALARM INTERRUPT STATUS.
- * @param:	None.
- * @return:	1 if the RTC interrupt occured, 0 otherwise.
- */
-volatile uint8_t RTC_get_wakeup_timer_flag(void) {
-	return rtc_wakeup_timer_flag;
-}
-
 /* CLEAR ALARM A INTERRUPT FLAG.
  * @param:	None.
  * @return:	None.
@@ -224,5 +228,58 @@ void RTC_clear_wakeup_timer_flag(void) {
 	// Clear flag.
 	RTC -> ISR &= ~(0b1 << 10); // WUTF='0'.
 	EXTI -> PR |= (0b1 << EXTI_LINE_RTC_WAKEUP_TIMER);
-	rtc_wakeup_timer_flag = 0;
+}
+
+/* GET CURRENT RTC TIME OF DAY IN MILLISECONDS.
+ * @param:	None.
+ * @return:	Time of day in ms (wraps every 24 hours).
+ * Note: the function is intended to compute durations, the calendar is never set.
+ */
+uint32_t RTC_get_time_ms(void) {
+	// Local variables.
+	uint32_t tr = 0;
+	uint32_t ssr = 0;
+	uint32_t prediv_s = ((RTC -> PRER) & 0x7FFF);
+	uint32_t time_ms = 0;
+	// Shadow registers are bypassed: read until two consecutive values are equal.
+	do {
+		tr = (RTC -> TR);
+		ssr = (RTC -> SSR) & 0xFFFF;
+	}
+	while ((tr != (RTC -> TR)) || (ssr != ((RTC -> SSR) & 0xFFFF)));
+	// Convert to milliseconds and add sub-seconds (down-counter).
+	time_ms = _RTC_get_seconds(tr) * 1000;
+	time_ms += ((prediv_s - ssr) * 1000) / (prediv_s + 1);
+	return time_ms;
+}
+
+/* GET CURRENT RTC TIME OF DAY IN SECONDS.
+ * @param:	None.
+ * @return:	Time of day in seconds (wraps every 24 hours).
+ * Note: sub-seconds are not read, which makes this function cheap enough to timestamp received bytes under interrupt.
+ */
+uint32_t RTC_get_time_seconds(void) {
+	// Local variables.
+	uint32_t tr = 0;
+	// Shadow registers are bypassed: read until two consecutive values are equal.
+	do {
+		tr = (RTC -> TR);
+	}
+	while (tr != (RTC -> TR));
+	return _RTC_get_seconds(tr);
+}
+
+/* COMPUTE TIME ELAPSED BETWEEN TWO RTC TIMES.
+ * @param start_time_ms:	Start time returned by RTC_get_time_ms().
+ * @param end_time_ms:		End time returned by RTC_get_time_ms().
+ * @return duration_ms:		Elapsed time in ms (durations longer than one day are not supported).
+ */
+uint32_t RTC_get_duration_ms(uint32_t start_time_ms, uint32_t end_time_ms) {
+	// Local variables.
+	uint32_t duration_ms = end_time_ms - start_time_ms;
+	// Manage RTC day wrap.
+	if (duration_ms > RTC_DAY_MS) {
+		duration_ms += RTC_DAY_MS;
+	}
+	return duration_ms;
 }
@@ -8,63 +8,136 @@
 #include "usart.h"
 
 #include "at.h"
+#include "dma.h"
+#include "exti.h"
 #include "gpio.h"
 #include "lptim.h"
 #include "mapping.h"
+#include "mode.h"
 #include "nvic.h"
+#include "prof.h"
+#include "pwr.h"
 #include "rcc.h"
 #include "rcc_reg.h"
+#include "string.h"
 #include "usart_reg.h"
 #include "types.h"
 
 /*** USART local macros ***/
 
-#define USART_BAUD_RATE			9600
-#define USART_TIMEOUT_COUNT		100000
+#define USART_BAUD_RATE_DEFAULT	9600
+#define USART_BRR_VALUE_MIN		16 // Oversampling by 16.
 #define USART_STRING_SIZE_MAX	1000
+#define USART_TX_BUFFER_SIZE	512 // Must be a power of 2.
+#define USART_RX_BUFFER_SIZE	64 // Must be a power of 2.
+#ifdef USART_USE_XON_XOFF
+#define USART_CHAR_XON			0x11
+#define USART_CHAR_XOFF			0x13
+#endif
+
+/*** USART local global variables ***/
+
+static const uint32_t USART_BAUD_RATE_LIST[] = {1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600, 1000000};
+
+/*** USART local structures ***/
+
+typedef struct {
+	// TX FIFO.
+	volatile uint8_t tx_buffer[USART_TX_BUFFER_SIZE];
+	volatile uint32_t tx_write_idx;
+	volatile uint32_t tx_read_idx;
+	// Statistics.
+	uint32_t tx_high_water_mark;
+	uint32_t tx_dropped_bytes;
+	uint32_t rx_overruns;
+	// Baud rate.
+	uint32_t baud_rate;
+	volatile uint32_t baud_rate_pending;
+	uint32_t baud_rate_previous;
+#ifdef USART_USE_XON_XOFF
+	// Software flow control.
+	volatile uint8_t tx_paused;
+#endif
+	// RX circular buffer (filled by DMA).
+	volatile uint8_t rx_buffer[USART_RX_BUFFER_SIZE];
+	volatile uint32_t rx_read_idx;
+} USART_context_t;
+
+static USART_context_t usart_ctx;
 
 /*** USART local functions ***/
 
+/* APPLY A NEW BAUD RATE.
+ * @param baud_rate:	Baud rate to apply.
+ * @return:				None.
+ */
+static void _USART2_apply_baud_rate(uint32_t baud_rate) {
+	// BRR can only be written when USART is disabled.
+	USART2 -> CR1 &= ~(0b1 << 0); // UE='0'.
+	USART2 -> BRR = (((uint32_t) RCC_HSI_FREQUENCY_KHZ * 1000) / (baud_rate)); // BRR = (fCK)/(baud rate). See p.730 of RM0377 datasheet.
+	USART2 -> CR1 |= (0b1 << 0); // UE='1'.
+	// Update context.
+	usart_ctx.baud_rate = baud_rate;
+}
+
 /* USART2 INTERRUPT HANDLER.
  * @param:	None.
  * @return:	None.
  */
 void __attribute__((optimize("-O0"))) USART2_IRQHandler(void) {
-	// RXNE interrupt.
-	if (((USART2 -> ISR) & (0b1 << 5)) != 0) {
-		// Transmit incoming byte to AT command manager.
-		AT_fill_rx_buffer(USART2 -> RDR);
-		// Clear RXNE flag.
-		USART2 -> RQR |= (0b1 << 3);
-	}
-	// Overrun error interrupt.
-	if (((USART2 -> ISR) & (0b1 << 3)) != 0) {
-		// Clear ORE flag.
-		USART2 -> ICR |= (0b1 << 3);
+	PROF_enter(PROF_PROBE_USART2_IRQ);
+	// Character match interrupt (end of line).
+	if ((((USART2 -> CR1) & (0b1 << 14)) != 0) && (((USART2 -> ISR) & (0b1 << 17)) != 0)) {
+		// Clear flag and process received bytes.
+		USART2 -> ICR |= (0b1 << 17);
+		USART2_process_rx_dma();
 	}
-}
-
-/* FILL USART TX BUFFER WITH A NEW BYTE.
- * @param tx_byte:	Byte to append.
- * @return status:	Function execution status.
- */
-static USART_status_t _USART2_fill_tx_buffer(uint8_t tx_byte) {
-	// Local variables.
-	USART_status_t status = USART_SUCCESS;
-	uint32_t loop_count = 0;
-	// Fill transmit register.
-	USART2 -> TDR = tx_byte;
-	// Wait for transmission to complete.
-	while (((USART2 -> ISR) & (0b1 << 7)) == 0) {
-		// Wait for TXE='1' or timeout.
-		loop_count++;
-		if (loop_count > USART_TIMEOUT_COUNT) {
-			status = USART_ERROR_TX_TIMEOUT;
-			goto errors;
+	// Idle line interrupt (end of line without CR or binary frame).
+	if ((((USART2 -> CR1) & (0b1 << 4)) != 0) && (((USART2 -> ISR) & (0b1 << 4)) != 0)) {
+		// Clear flag and process received bytes.
+		USART2 -> ICR |= (0b1 << 4);
+		USART2_process_rx_dma();
+	}
+	// TXE interrupt.
+	if ((((USART2 -> CR1) & (0b1 << 7)) != 0) && (((USART2 -> ISR) & (0b1 << 7)) != 0)) {
+		// Check if there are remaining bytes to send.
+		if (usart_ctx.tx_read_idx != usart_ctx.tx_write_idx) {
+			// Fill transmit register.
+			USART2 -> TDR = usart_ctx.tx_buffer[usart_ctx.tx_read_idx];
+			usart_ctx.tx_read_idx = (usart_ctx.tx_read_idx + 1) & (USART_TX_BUFFER_SIZE - 1);
+		}
+		else {
+			// FIFO empty.
+			USART2 -> CR1 &= ~(0b1 << 7); // TXEIE='0'.
+			// Wait for the last byte to be completely sent before changing baud rate.
+			if (usart_ctx.baud_rate_pending != 0) {
+				USART2 -> CR1 |= (0b1 << 6); // TCIE='1'.
+			}
 		}
 	}
-errors:
-	return status;
+	// TC interrupt (pending baud rate switch).
+	if ((((USART2 -> CR1) & (0b1 << 6)) != 0) && (((USART2 -> ISR) & (0b1 << 6)) != 0)) {
+		// Clear flag and disable interrupt.
+		USART2 -> ICR |= (0b1 << 6);
+		USART2 -> CR1 &= ~(0b1 << 6); // TCIE='0'.
+		// Switch baud rate and keep previous one until host confirmation.
+		usart_ctx.baud_rate_previous = usart_ctx.baud_rate;
+		_USART2_apply_baud_rate(usart_ctx.baud_rate_pending);
+		usart_ctx.baud_rate_pending = 0;
+	}
+	// Wake-up interrupt (RX data is handled by DMA once the core is running).
+	if ((((USART2 -> CR3) & (0b1 << 22)) != 0) && (((USART2 -> ISR) & (0b1 << 20)) != 0)) {
+		// Clear flag.
+		USART2 -> ICR |= (0b1 << 20);
+	}
+	// Error interrupt.
+	if (((USART2 -> ISR) & (0b1 << 3)) != 0) {
+		// Count lost bytes.
+		usart_ctx.rx_overruns++;
+	}
+	// Clear ORE, NF and FE flags.
+	USART2 -> ICR |= (0b111 << 1);
+	PROF_exit(PROF_PROBE_USART2_IRQ);
 }
 
 /*** USART functions ***/
@@ -74,6 +147,17 @@ errors:
  * @return:	None.
  */
 void USART2_init(void) {
+	// Init context.
+	usart_ctx.tx_write_idx = 0;
+	usart_ctx.tx_read_idx = 0;
+	usart_ctx.rx_read_idx = 0;
+	usart_ctx.baud_rate = USART_BAUD_RATE_DEFAULT;
+	usart_ctx.baud_rate_pending = 0;
+	usart_ctx.baud_rate_previous = 0;
+#ifdef USART_USE_XON_XOFF
+	usart_ctx.tx_paused = 0;
+#endif
+	USART2_reset_statistics();
 	// Enable peripheral clock.
 	RCC -> CR |= (0b1 << 1); // Enable HSI in stop mode (HSI16KERON='1').
 	RCC -> CCIPR |= (0b10 << 2); // Select HSI as USART clock.
@@ -83,37 +167,157 @@ void USART2_init(void) {
 	GPIO_configure(&GPIO_USART2_TX, GPIO_MODE_ALTERNATE_FUNCTION, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_HIGH, GPIO_PULL_NONE);
 	GPIO_configure(&GPIO_USART2_RX, GPIO_MODE_ALTERNATE_FUNCTION, GPIO_TYPE_PUSH_PULL, GPIO_SPEED_HIGH, GPIO_PULL_NONE);
 	// Configure peripheral.
-	USART2 -> CR3 |= (0b1 << 12) | (0b1 << 23); // No overrun detection (OVRDIS='1') and clock enable in stop mode (UCESM='1').
-	USART2 -> BRR = ((RCC_HSI_FREQUENCY_KHZ * 1000) / (USART_BAUD_RATE)); // BRR = (fCK)/(baud rate). See p.730 of RM0377 datasheet.
+	USART2 -> CR2 |= (STRING_CHAR_CR << 24); // Character match on line end.
+	USART2 -> CR3 |= (0b1 << 23) | (0b10 << 20); // Clock enable in stop mode (UCESM='1') and wake-up on start bit detection (WUS='10').
+	USART2 -> CR3 |= (0b1 << 6) | (0b1 << 0); // Reception handled by DMA (DMAR='1') and error interrupt enabled to count overruns (EIE='1').
+	USART2 -> BRR = (((uint32_t) RCC_HSI_FREQUENCY_KHZ * 1000) / (USART_BAUD_RATE_DEFAULT)); // BRR = (fCK)/(baud rate). See p.730 of RM0377 datasheet.
 	// Enable transmitter and receiver.
-	USART2 -> CR1 |= (0b1 << 5) | (0b11 << 2); // TE='1', RE='1' and RXNEIE='1'.
+	USART2 -> CR1 |= (0b11 << 2); // TE='1' and RE='1'.
+	// Start circular reception.
+	DMA1_CH5_init();
+	DMA1_CH5_stop();
+	DMA1_CH5_set_destination_address((uint32_t) usart_ctx.rx_buffer, USART_RX_BUFFER_SIZE);
+	DMA1_CH5_start();
 	// Set interrupt priority.
 	NVIC_set_priority(NVIC_INTERRUPT_USART2, 3);
-	// Enable peripheral.
-	USART2 -> CR1 |= (0b11 << 0);
+	EXTI_configure_line(EXTI_LINE_USART2, EXTI_TRIGGER_RISING_EDGE);
+	// Enable peripheral (UESM is only set before entering stop mode, see USART2_enable_wake_up() function).
+	USART2 -> CR1 |= (0b1 << 0); // UE='1'.
+	// Enable interrupt (used by TX FIFO whatever the RX interrupt state).
+	NVIC_enable_interrupt(NVIC_INTERRUPT_USART2);
 }
 
-/* ENABLE USART INTERRUPT.
+/* ENABLE USART RX INTERRUPTS.
  * @param:	None.
  * @return:	None.
  */
 void USART2_enable_interrupt(void) {
-	// Clear flag and enable interrupt.
-	USART2 -> RQR |= (0b1 << 3);
-	NVIC_enable_interrupt(NVIC_INTERRUPT_USART2);
+	// Discard bytes received while RX interrupts were disabled.
+	usart_ctx.rx_read_idx = (USART_RX_BUFFER_SIZE - DMA1_CH5_get_number_of_remaining_transfers()) & (USART_RX_BUFFER_SIZE - 1);
+	// Clear flags and enable interrupts.
+	USART2 -> ICR |= (0b1 << 17) | (0b1 << 4); // CMCF='1' and IDLECF='1'.
+	USART2 -> CR1 |= (0b1 << 14) | (0b1 << 4); // CMIE='1' and IDLEIE='1'.
 }
 
-/* DISABLE USART INTERRUPT.
+/* DISABLE USART RX INTERRUPTS.
  * @param:	None.
  * @return:	None.
  */
 void USART2_disable_interrupt(void) {
-	// Disable interrupt.
-	NVIC_disable_interrupt(NVIC_INTERRUPT_USART2);
+	// Disable interrupts.
+	USART2 -> CR1 &= ~((0b1 << 14) | (0b1 << 4)); // CMIE='0' and IDLEIE='0'.
+}
+
+/* ENABLE USART WAKE-UP FROM STOP MODE.
+ * @param:	None.
+ * @return:	None.
+ * Note: the start bit detection wakes-up the core before the end of the first byte, which is then transferred by DMA.
+ */
+void USART2_enable_wake_up(void) {
+	// Clear flag and enable wake-up interrupt.
+	USART2 -> ICR |= (0b1 << 20); // WUCF='1'.
+	USART2 -> CR3 |= (0b1 << 22); // WUFIE='1'.
+	USART2 -> CR1 |= (0b1 << 1); // UESM='1'.
+}
+
+/* DISABLE USART WAKE-UP FROM STOP MODE.
+ * @param:	None.
+ * @return:	None.
+ */
+void USART2_disable_wake_up(void) {
+	// Disable wake-up interrupt.
+	USART2 -> CR1 &= ~(0b1 << 1); // UESM='0'.
+	USART2 -> CR3 &= ~(0b1 << 22); // WUFIE='0'.
+}
+
+/* CHECK IF USART CAN BE STOPPED.
+ * @param:	None.
+ * @return:	1 if there is no transmission, reception or unprocessed RX data, 0 otherwise.
+ */
+uint8_t USART2_is_idle(void) {
+	// Local variables.
+	uint8_t idle = 0;
+	uint32_t write_idx = (USART_RX_BUFFER_SIZE - DMA1_CH5_get_number_of_remaining_transfers()) & (USART_RX_BUFFER_SIZE - 1);
+	// Check TX FIFO, pending baud rate switch, transmission complete and busy flags and RX buffer.
+	if ((usart_ctx.tx_read_idx == usart_ctx.tx_write_idx) && (usart_ctx.baud_rate_pending == 0) && (((USART2 -> ISR) & (0b1 << 6)) != 0) && (((USART2 -> ISR) & (0b1 << 16)) == 0) && (usart_ctx.rx_read_idx == write_idx)) {
+		idle = 1;
+	}
+	return idle;
+}
+
+/* FORWARD BYTES RECEIVED BY DMA TO THE AT MANAGER (CALLED BY USART AND DMA INTERRUPTS).
+ * @param:	None.
+ * @return:	None.
+ */
+void USART2_process_rx_dma(void) {
+	// Local variables.
+	uint32_t write_idx = (USART_RX_BUFFER_SIZE - DMA1_CH5_get_number_of_remaining_transfers()) & (USART_RX_BUFFER_SIZE - 1);
+	uint8_t rx_byte = 0;
+	// Bytes loop.
+	while (usart_ctx.rx_read_idx != write_idx) {
+		rx_byte = usart_ctx.rx_buffer[usart_ctx.rx_read_idx];
+		usart_ctx.rx_read_idx = (usart_ctx.rx_read_idx + 1) & (USART_RX_BUFFER_SIZE - 1);
+#ifdef USART_USE_XON_XOFF
+		// Flow control characters are not forwarded.
+		if (rx_byte == USART_CHAR_XOFF) {
+			usart_ctx.tx_paused = 1;
+			USART2 -> CR1 &= ~(0b1 << 7); // TXEIE='0'.
+			continue;
+		}
+		if (rx_byte == USART_CHAR_XON) {
+			usart_ctx.tx_paused = 0;
+			USART2 -> CR1 |= (0b1 << 7); // TXEIE='1'.
+			continue;
+		}
+#endif
+		AT_fill_rx_buffer(rx_byte);
+	}
 }
 
 /* SEND A BYTE ARRAY THROUGH USART2.
- * @param tx_string:	Byte array to send.
+ * @param tx_data:		Byte array to send.
+ * @param tx_data_size:	Number of bytes to send.
+ * @return status:		Function execution status.
+ * Note: the array is only copied in the TX FIFO (or dropped as a whole if there is not enough space), bytes are sent under interrupt.
+ */
+USART_status_t USART2_send_bytes(uint8_t* tx_data, uint32_t tx_data_size) {
+	// Local variables.
+	USART_status_t status = USART_SUCCESS;
+	uint32_t fifo_level = 0;
+	uint32_t idx = 0;
+	// Check parameter.
+	if (tx_data == NULL) {
+		status = USART_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	// Check free space.
+	fifo_level = (usart_ctx.tx_write_idx - usart_ctx.tx_read_idx) & (USART_TX_BUFFER_SIZE - 1);
+	if ((fifo_level + tx_data_size) >= USART_TX_BUFFER_SIZE) {
+		usart_ctx.tx_dropped_bytes += tx_data_size;
+		status = USART_ERROR_TX_BUFFER_FULL;
+		goto errors;
+	}
+	// Fill FIFO.
+	for (idx=0 ; idx<tx_data_size ; idx++) {
+		usart_ctx.tx_buffer[usart_ctx.tx_write_idx] = tx_data[idx];
+		usart_ctx.tx_write_idx = (usart_ctx.tx_write_idx + 1) & (USART_TX_BUFFER_SIZE - 1);
+	}
+	// Update statistics.
+	fifo_level += tx_data_size;
+	if (fifo_level > usart_ctx.tx_high_water_mark) {
+		usart_ctx.tx_high_water_mark = fifo_level;
+	}
+	// Start transmission.
+#ifdef USART_USE_XON_XOFF
+	if (usart_ctx.tx_paused != 0) goto errors;
+#endif
+	USART2 -> CR1 |= (0b1 << 7); // TXEIE='1'.
+errors:
+	return status;
+}
+
+/* SEND A STRING THROUGH USART2.
+ * @param tx_string:	String to send.
  * @return status:		Function execution status.
  */
 USART_status_t USART2_send_string(char_t* tx_string) {
@@ -125,18 +329,161 @@ USART_status_t USART2_send_string(char_t* tx_string) {
 		status = USART_ERROR_NULL_PARAMETER;
 		goto errors;
 	}
-	// Loop on all characters.
-	while (*tx_string) {
-		// Fill TX buffer with new byte.
-		status = _USART2_fill_tx_buffer((uint8_t) *(tx_string++));
-		if (status != USART_SUCCESS) goto errors;
+	// Compute string size.
+	while (tx_string[char_count] != STRING_CHAR_NULL) {
 		// Check character count.
 		char_count++;
 		if (char_count > USART_STRING_SIZE_MAX) {
 			status = USART_ERROR_STRING_SIZE;
+			goto errors;
+		}
+	}
+	// Send characters.
+	status = USART2_send_bytes((uint8_t*) tx_string, char_count);
+errors:
+	return status;
+}
+
+/* WAIT FOR USART2 TX FIFO TO BE EMPTY.
+ * @param:	None.
+ * @return:	None.
+ * Note: used before printing long lists which do not fit in the TX FIFO, the function also waits for a pending baud rate switch to be applied.
+ * With software flow control, the function returns as soon as the host has paused the transmission (XOFF),
+ * since the FIFO will not drain until the host resumes it.
+ */
+void USART2_flush(void) {
+	// Local variables.
+	uint8_t flush_done = 0;
+	// Sleep until all bytes have been sent (woken-up by TXE and TC interrupts).
+	// Interrupts are masked while checking the FIFO so that the last TXE interrupt can not occur just before WFI.
+	while (1) {
+		__asm volatile ("cpsid i");
+		flush_done = ((usart_ctx.tx_read_idx == usart_ctx.tx_write_idx) && (usart_ctx.baud_rate_pending == 0)) ? 1 : 0;
+#ifdef USART_USE_XON_XOFF
+		if (usart_ctx.tx_paused != 0) {
+			flush_done = 1;
+		}
+#endif
+		if (flush_done == 0) {
+			PWR_enter_sleep_mode();
+		}
+		__asm volatile ("cpsie i");
+		if (flush_done != 0) break;
+	}
+}
+
+/* GET USART2 TX FIFO HIGH WATER MARK.
+ * @param:	None.
+ * @return:	Maximum number of bytes stored in the TX FIFO since last reset.
+ */
+uint32_t USART2_get_tx_high_water_mark(void) {
+	return usart_ctx.tx_high_water_mark;
+}
+
+/* GET USART2 TX FIFO DROPPED BYTES COUNT.
+ * @param:	None.
+ * @return:	Number of bytes dropped because the TX FIFO was full since last reset.
+ */
+uint32_t USART2_get_tx_dropped_bytes(void) {
+	return usart_ctx.tx_dropped_bytes;
+}
+
+/* GET USART2 RX OVERRUNS COUNT.
+ * @param:	None.
+ * @return:	Number of overrun errors detected since last reset.
+ */
+uint32_t USART2_get_rx_overruns(void) {
+	return usart_ctx.rx_overruns;
+}
+
+/* RESET USART2 STATISTICS.
+ * @param:	None.
+ * @return:	None.
+ */
+void USART2_reset_statistics(void) {
+	usart_ctx.tx_high_water_mark = 0;
+	usart_ctx.tx_dropped_bytes = 0;
+	usart_ctx.rx_overruns = 0;
+}
+
+/* REQUEST A NEW USART2 BAUD RATE.
+ * @param baud_rate:	New baud rate.
+ * @return status:		Function execution status.
+ * Note: the switch is applied once the TX FIFO is empty, so that the current reply is still sent at the previous baud rate.
+ * The new baud rate must then be confirmed with USART2_confirm_baud_rate(), otherwise it can be reverted with USART2_revert_baud_rate().
+ */
+USART_status_t USART2_set_baud_rate(uint32_t baud_rate) {
+	// Local variables.
+	USART_status_t status = USART_ERROR_BAUD_RATE;
+	uint8_t idx = 0;
+	// Check parameter.
+	for (idx=0 ; idx<(sizeof(USART_BAUD_RATE_LIST) / sizeof(uint32_t)) ; idx++) {
+		if (USART_BAUD_RATE_LIST[idx] == baud_rate) {
+			status = USART_SUCCESS;
 			break;
 		}
 	}
+	if (status != USART_SUCCESS) goto errors;
+	if ((((uint32_t) RCC_HSI_FREQUENCY_KHZ * 1000) / (baud_rate)) < USART_BRR_VALUE_MIN) {
+		status = USART_ERROR_BAUD_RATE;
+		goto errors;
+	}
+	// Nothing to do if baud rate is already applied.
+	if (baud_rate == usart_ctx.baud_rate) goto errors;
+	// Register switch request.
+	usart_ctx.baud_rate_pending = baud_rate;
+	USART2 -> CR1 |= (0b1 << 7); // TXEIE='1' (switch is performed by interrupt when TX FIFO is empty).
 errors:
 	return status;
 }
+
+/* GET CURRENT USART2 BAUD RATE.
+ * @param:	None.
+ * @return:	Current baud rate.
+ */
+uint32_t USART2_get_baud_rate(void) {
+	return usart_ctx.baud_rate;
+}
+
+/* GET USART2 BAUD RATE SWITCH STATUS.
+ * @param:	None.
+ * @return:	Baud rate status.
+ */
+USART_baud_rate_status_t USART2_get_baud_rate_status(void) {
+	// Local variables.
+	USART_baud_rate_status_t baud_rate_status = USART_BAUD_RATE_STATUS_CONFIRMED;
+	// Check context.
+	if (usart_ctx.baud_rate_pending != 0) {
+		baud_rate_status = USART_BAUD_RATE_STATUS_PENDING;
+	}
+	else if (usart_ctx.baud_rate_previous != 0) {
+		baud_rate_status = USART_BAUD_RATE_STATUS_UNCONFIRMED;
+	}
+	return baud_rate_status;
+}
+
+/* CONFIRM CURRENT USART2 BAUD RATE.
+ * @param:	None.
+ * @return:	None.
+ */
+void USART2_confirm_baud_rate(void) {
+	// Apply pending switch immediately if any (boot configuration).
+	if (usart_ctx.baud_rate_pending != 0) {
+		USART2 -> CR1 &= ~(0b1 << 6); // TCIE='0'.
+		_USART2_apply_baud_rate(usart_ctx.baud_rate_pending);
+		usart_ctx.baud_rate_pending = 0;
+	}
+	usart_ctx.baud_rate_previous = 0;
+}
+
+/* GO BACK TO THE PREVIOUS USART2 BAUD RATE.
+ * @param:	None.
+ * @return:	None.
+ * Note: called when the host did not confirm the new baud rate in time.
+ */
+void USART2_revert_baud_rate(void) {
+	// Check previous value.
+	if (usart_ctx.baud_rate_previous == 0) return;
+	_USART2_apply_baud_rate(usart_ctx.baud_rate_previous);
+	usart_ctx.baud_rate_previous = 0;
+}
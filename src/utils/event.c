@@ -0,0 +1,55 @@
+/*
+ * event.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "event.h"
+
+#include "types.h"
+
+/*** EVENT local global variables ***/
+
+// One byte per event so that posting (interrupt) and taking (main loop) are single atomic accesses.
+static volatile uint8_t event_flags[EVENT_LAST];
+
+/*** EVENT functions ***/
+
+/* POST AN EVENT (CALLED BY INTERRUPTS OR TASKS).
+ * @param event:	Event to post.
+ * @return:			None.
+ */
+void EVENT_post(EVENT_t event) {
+	// Check parameter.
+	if (event >= EVENT_LAST) return;
+	// Set flag.
+	event_flags[event] = 1;
+}
+
+/* READ AND CLEAR AN EVENT.
+ * @param event:	Event to check.
+ * @return:			1 if the event was pending, 0 otherwise.
+ * Note: the flag is cleared before the task runs, so that an event posted during the task execution is not lost.
+ */
+uint8_t EVENT_take(EVENT_t event) {
+	// Check parameter.
+	if ((event >= EVENT_LAST) || (event_flags[event] == 0)) return 0;
+	// Clear flag.
+	event_flags[event] = 0;
+	return 1;
+}
+
+/* CHECK IF ANY EVENT IS PENDING.
+ * @param:	None.
+ * @return:	1 if at least one event is pending, 0 otherwise.
+ */
+uint8_t EVENT_is_pending(void) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Flags loop.
+	for (idx=0 ; idx<EVENT_LAST ; idx++) {
+		if (event_flags[idx] != 0) return 1;
+	}
+	return 0;
+}
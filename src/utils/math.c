@@ -55,34 +55,153 @@ static const uint32_t MATH_POW10[MATH_DECIMAL_MAX_SIZE] = {1, 10, 100, 1000, 100
 	} \
 }
 
+/* GENERIC MACRO TO SWAP TWO ELEMENTS OF THE LOCAL BUFFER.
+ * @param idx_a:	Index of the first element.
+ * @param idx_b:	Index of the second element.
+ * @return:			None.
+ */
+#define _MATH_swap(idx_a, idx_b) { \
+	temp = local_buf[idx_a]; \
+	local_buf[idx_a] = local_buf[idx_b]; \
+	local_buf[idx_b] = temp; \
+}
+
+/* GENERIC MACRO TO ORDER TWO ELEMENTS OF THE LOCAL BUFFER (SORTING NETWORK COMPARATOR).
+ * @param idx_a:	Index of the element which will contain the lowest value.
+ * @param idx_b:	Index of the element which will contain the highest value.
+ * @return:			None.
+ */
+#define _MATH_compare_and_swap(idx_a, idx_b) { \
+	if (local_buf[idx_a] > local_buf[idx_b]) { \
+		_MATH_swap(idx_a, idx_b); \
+	} \
+}
+
+/* GENERIC MACRO TO SORT 3 ELEMENTS OF THE LOCAL BUFFER (3 COMPARATORS NETWORK).
+ * @param:	None.
+ * @return:	None.
+ */
+#define _MATH_sort_3() { \
+	_MATH_compare_and_swap(0, 1); \
+	_MATH_compare_and_swap(1, 2); \
+	_MATH_compare_and_swap(0, 1); \
+}
+
+/* GENERIC MACRO TO SORT 5 ELEMENTS OF THE LOCAL BUFFER (9 COMPARATORS NETWORK).
+ * @param:	None.
+ * @return:	None.
+ */
+#define _MATH_sort_5() { \
+	_MATH_compare_and_swap(0, 1); \
+	_MATH_compare_and_swap(3, 4); \
+	_MATH_compare_and_swap(2, 4); \
+	_MATH_compare_and_swap(2, 3); \
+	_MATH_compare_and_swap(0, 3); \
+	_MATH_compare_and_swap(0, 2); \
+	_MATH_compare_and_swap(1, 4); \
+	_MATH_compare_and_swap(1, 3); \
+	_MATH_compare_and_swap(1, 2); \
+}
+
+/* GENERIC MACRO TO SORT 9 ELEMENTS OF THE LOCAL BUFFER (25 COMPARATORS NETWORK).
+ * @param:	None.
+ * @return:	None.
+ */
+#define _MATH_sort_9() { \
+	_MATH_compare_and_swap(0, 1); \
+	_MATH_compare_and_swap(3, 4); \
+	_MATH_compare_and_swap(6, 7); \
+	_MATH_compare_and_swap(1, 2); \
+	_MATH_compare_and_swap(4, 5); \
+	_MATH_compare_and_swap(7, 8); \
+	_MATH_compare_and_swap(0, 1); \
+	_MATH_compare_and_swap(3, 4); \
+	_MATH_compare_and_swap(6, 7); \
+	_MATH_compare_and_swap(0, 3); \
+	_MATH_compare_and_swap(3, 6); \
+	_MATH_compare_and_swap(0, 3); \
+	_MATH_compare_and_swap(1, 4); \
+	_MATH_compare_and_swap(4, 7); \
+	_MATH_compare_and_swap(1, 4); \
+	_MATH_compare_and_swap(2, 5); \
+	_MATH_compare_and_swap(5, 8); \
+	_MATH_compare_and_swap(2, 5); \
+	_MATH_compare_and_swap(1, 3); \
+	_MATH_compare_and_swap(5, 7); \
+	_MATH_compare_and_swap(2, 6); \
+	_MATH_compare_and_swap(4, 6); \
+	_MATH_compare_and_swap(2, 4); \
+	_MATH_compare_and_swap(2, 3); \
+	_MATH_compare_and_swap(5, 6); \
+}
+
+/* GENERIC MACRO TO PUT THE K-TH SMALLEST ELEMENT OF THE LOCAL BUFFER AT INDEX K (QUICKSELECT).
+ * @param k:			Rank of the element to select.
+ * @param left_idx:		First index of the search window.
+ * @param right_idx:	Last index of the search window.
+ * @return:				None.
+ * Note: on exit, elements before index k are lower or equal and elements after index k are greater or equal.
+ */
+#define _MATH_quickselect(k, left_idx, right_idx) { \
+	uint8_t left = (left_idx); \
+	uint8_t right = (right_idx); \
+	uint8_t store_idx = 0; \
+	uint8_t idx = 0; \
+	while (left < right) { \
+		/* Use middle element as pivot and move it at the end of the window */ \
+		_MATH_swap(((left + right) / 2), right); \
+		store_idx = left; \
+		for (idx=left ; idx<right ; idx++) { \
+			if (local_buf[idx] < local_buf[right]) { \
+				_MATH_swap(idx, store_idx); \
+				store_idx++; \
+			} \
+		} \
+		_MATH_swap(store_idx, right); \
+		/* Continue in the partition which contains k */ \
+		if (store_idx == (k)) break; \
+		if (store_idx < (k)) { \
+			left = (store_idx + 1); \
+		} \
+		else { \
+			right = (store_idx - 1); \
+		} \
+	} \
+}
+
+/* GENERIC MACRO TO SORT A WINDOW OF THE LOCAL BUFFER (INSERTION SORT).
+ * @param left_idx:		First index of the window.
+ * @param right_idx:	Last index of the window.
+ * @return:				None.
+ */
+#define _MATH_insertion_sort(left_idx, right_idx) { \
+	uint8_t idx1 = 0; \
+	uint8_t idx2 = 0; \
+	for (idx1=((left_idx) + 1) ; idx1<=(right_idx) ; idx1++) { \
+		temp = local_buf[idx1]; \
+		for (idx2=idx1 ; (idx2>(left_idx)) && (local_buf[idx2 - 1] > temp) ; idx2--) { \
+			local_buf[idx2] = local_buf[idx2 - 1]; \
+		} \
+		local_buf[idx2] = temp; \
+	} \
+}
+
 /* GENERIC FUNCTION TO COMPUTE AVERAGE MEDIAN VALUE OF AN ARRAY.
  * @param data:				Input buffer.
  * @param median_length:	Number of elements taken for median value search.
  * @param average_length:	Number of center elements taken for final average.
  * @return filter_out:		Output value of the median filter.
+ * Note: on exit, the center elements of the local buffer (from start_idx to end_idx) are sorted in ascending order.
  */
 #define _MATH_median_filter(data, median_length, average_length) { \
-	uint8_t buffer_sorted = 0; \
 	uint8_t idx1 = 0; \
-	uint8_t idx2 = 0; \
 	/* Copy input buffer into local buffer */ \
 	for (idx1=0 ; idx1<median_length ; idx1++) { \
 		local_buf[idx1] = data[idx1]; \
 	} \
-	/* Sort buffer in ascending order. */ \
-	for (idx1=0; idx1<median_length; ++idx1) { \
-		buffer_sorted = 1; \
-		for (idx2=1 ; idx2<(median_length-idx1) ; ++idx2) { \
-			if (local_buf[idx2 - 1] > local_buf[idx2]) { \
-				temp = local_buf[idx2 - 1]; \
-				local_buf[idx2 - 1] = local_buf[idx2]; \
-				local_buf[idx2] = temp; \
-				buffer_sorted = 0; \
-			} \
-		} \
-		if (buffer_sorted != 0) break; \
-	} \
 	/* Compute start and end indexes for final averaging */ \
+	start_idx = (median_length / 2); \
+	end_idx = start_idx; \
 	if (average_length > 0) { \
 		/* Clamp value */ \
 		if (average_length > median_length) { \
@@ -94,6 +213,27 @@ static const uint32_t MATH_POW10[MATH_DECIMAL_MAX_SIZE] = {1, 10, 100, 1000, 100
 			end_idx = (median_length - 1); \
 		} \
 	} \
+	/* Use sorting networks for common sizes and quickselect otherwise */ \
+	switch (median_length) { \
+	case 0: \
+		break; \
+	case 3: \
+		_MATH_sort_3(); \
+		break; \
+	case 5: \
+		_MATH_sort_5(); \
+		break; \
+	case 9: \
+		_MATH_sort_9(); \
+		break; \
+	default: \
+		_MATH_quickselect(end_idx, 0, (median_length - 1)); \
+		if (start_idx < end_idx) { \
+			_MATH_quickselect(start_idx, 0, (end_idx - 1)); \
+			_MATH_insertion_sort(start_idx, end_idx); \
+		} \
+		break; \
+	} \
 }
 
 /* GENERIC MACRO TO CHECK RESULT INPUT POINTER.
@@ -330,7 +470,7 @@ errors:
 	_MATH_median_filter(data, median_length, average_length);
 	// Compute average or median value.
 	if (average_length > 0) {
-		status = MATH_average_u8(&(data[start_idx]), (end_idx - start_idx + 1), result);
+		status = MATH_average_u8(&(local_buf[start_idx]), (end_idx - start_idx + 1), result);
 	}
 	else {
 		(*result) = local_buf[(median_length / 2)];
@@ -360,7 +500,7 @@ errors:
 	_MATH_median_filter(data, median_length, average_length);
 	// Compute average or median value.
 	if (average_length > 0) {
-		status = MATH_average_u16(&(data[start_idx]), (end_idx - start_idx + 1), result);
+		status = MATH_average_u16(&(local_buf[start_idx]), (end_idx - start_idx + 1), result);
 	}
 	else {
 		(*result) = local_buf[(median_length / 2)];
@@ -390,7 +530,7 @@ errors:
 	_MATH_median_filter(data, median_length, average_length);
 	// Compute average or median value.
 	if (average_length > 0) {
-		status = MATH_average_u32(&(data[start_idx]), (end_idx - start_idx + 1), result);
+		status = MATH_average_u32(&(local_buf[start_idx]), (end_idx - start_idx + 1), result);
 	}
 	else {
 		(*result) = local_buf[(median_length / 2)];
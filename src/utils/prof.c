@@ -0,0 +1,117 @@
+/*
+ * prof.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "prof.h"
+
+#include "mode.h"
+#include "systick_reg.h"
+#include "types.h"
+
+#ifdef PROFILING
+
+/*** PROF local macros ***/
+
+#define PROF_SYSTICK_MASK	0x00FFFFFF // 24-bits down counter.
+
+/*** PROF local structures ***/
+
+typedef struct {
+	PROF_statistics_t statistics[PROF_PROBE_LAST];
+	volatile uint32_t start_value[PROF_PROBE_LAST];
+} PROF_context_t;
+
+/*** PROF local global variables ***/
+
+static PROF_context_t prof_ctx;
+
+/*** PROF functions ***/
+
+/* INIT PROFILING TIMEBASE.
+ * @param:	None.
+ * @return:	None.
+ * Note: SysTick is clocked by the core clock and is not running in stop mode, durations longer than 2^24 cycles are not measurable.
+ */
+void PROF_init(void) {
+	// Reset statistics.
+	PROF_reset_statistics();
+	// Configure SysTick as free running down counter without interrupt.
+	SYSTICK -> CSR = 0;
+	SYSTICK -> RVR = PROF_SYSTICK_MASK;
+	SYSTICK -> CVR = 0;
+	SYSTICK -> CSR |= (0b1 << 2) | (0b1 << 0); // CLKSOURCE='1' (core clock) and ENABLE='1'.
+}
+
+/* START A PROBE MEASUREMENT.
+ * @param probe:	Probe to start.
+ * @return:			None.
+ */
+void PROF_start_probe(PROF_probe_t probe) {
+	// Store current counter value.
+	prof_ctx.start_value[probe] = (SYSTICK -> CVR);
+}
+
+/* STOP A PROBE MEASUREMENT AND UPDATE ITS STATISTICS.
+ * @param probe:	Probe to stop.
+ * @return:			None.
+ * Note: durations include the execution time of the interrupts which preempted the probed code.
+ */
+void PROF_stop_probe(PROF_probe_t probe) {
+	// Local variables.
+	uint32_t cycles = (prof_ctx.start_value[probe] - (SYSTICK -> CVR)) & PROF_SYSTICK_MASK;
+	PROF_statistics_t* statistics = &(prof_ctx.statistics[probe]);
+	// Update statistics (count and total are frozen together so that the average remains valid).
+	if ((statistics -> count) < PROF_COUNT_MAX) {
+		(statistics -> count)++;
+		(statistics -> total_cycles) += cycles;
+	}
+	if (cycles < (statistics -> min_cycles)) {
+		(statistics -> min_cycles) = cycles;
+	}
+	if (cycles > (statistics -> max_cycles)) {
+		(statistics -> max_cycles) = cycles;
+	}
+}
+
+/* READ PROBE STATISTICS.
+ * @param probe:		Probe to read.
+ * @param statistics:	Pointer that will contain the probe statistics.
+ * @return:				None.
+ */
+void PROF_get_statistics(PROF_probe_t probe, PROF_statistics_t* statistics) {
+	// Local variables.
+	uint32_t primask = 0;
+	// Check parameters.
+	if ((probe >= PROF_PROBE_LAST) || (statistics == NULL)) return;
+	// Copy statistics with interrupts masked since they may be updated by interrupt probes.
+	// Previous PRIMASK is restored so that interrupts stay masked if the caller had masked them.
+	__asm volatile ("mrs %0, primask" : "=r" (primask));
+	__asm volatile ("cpsid i");
+	(*statistics) = prof_ctx.statistics[probe];
+	__asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+}
+
+/* RESET ALL PROBES STATISTICS.
+ * @param:	None.
+ * @return:	None.
+ */
+void PROF_reset_statistics(void) {
+	// Local variables.
+	uint32_t primask = 0;
+	uint8_t idx = 0;
+	// Reset all probes with interrupts masked (previous PRIMASK is restored).
+	__asm volatile ("mrs %0, primask" : "=r" (primask));
+	__asm volatile ("cpsid i");
+	for (idx=0 ; idx<PROF_PROBE_LAST ; idx++) {
+		prof_ctx.statistics[idx].count = 0;
+		prof_ctx.statistics[idx].min_cycles = PROF_SYSTICK_MASK;
+		prof_ctx.statistics[idx].max_cycles = 0;
+		prof_ctx.statistics[idx].total_cycles = 0;
+	}
+	__asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+}
+
+#endif
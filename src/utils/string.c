@@ -8,6 +8,7 @@
 #include "string.h"
 
 #include "math.h"
+#include "prof.h"
 #include "types.h"
 
 /*** STRING local macros ***/
@@ -16,6 +17,24 @@
 #define STRING_DIGIT_DECIMAL_MAX			9
 #define STRING_DIGIT_HEXADECIMAL_MAX		0x0F
 #define STRING_HEXADECICMAL_DIGIT_PER_BYTE	2
+#define STRING_DECIMAL_DIGIT_PER_CHUNK		4
+
+/*** STRING local global variables ***/
+
+static const char_t STRING_DECIMAL_DIGIT_PAIRS[200] = {
+	'0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+	'1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+	'2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+	'3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+	'4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+	'5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+	'6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+	'7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+	'8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+	'9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+static const char_t STRING_HEXADECIMAL_DIGITS[16] = {'0','1','2','3','4','5','6','7','8','9','A','B','C','D','E','F'};
+static const uint32_t STRING_DECIMAL_THRESHOLDS[MATH_DECIMAL_MAX_SIZE - 1] = {10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
 
 /*** STRING local functions ***/
 
@@ -58,25 +77,6 @@ errors:
 	return status;
 }
 
-/* RETURN CORRESPONDING ASCII CHARACTER OF A GIVEN DECIMAL VALUE.
- * @param value:	Decimal digit.
- * @return chr:		Corresponding ASCII code.
- */
-static STRING_status_t _STRING_decimal_value_to_char(uint8_t value, char_t* chr) {
-	// Local variables.
-	STRING_status_t status = STRING_SUCCESS;
-	// Check parameters.
-	if (value > STRING_DIGIT_DECIMAL_MAX) {
-		status = STRING_ERROR_DECIMAL_OVERFLOW;
-		goto errors;
-	}
-	_STRING_check_pointer(chr);
-	// Perform conversion.
-	(*chr) = (value + '0');
-errors:
-	return status;
-}
-
 /* CHECK IF A GIVEN ASCII CODE CORRESPONDS TO AN HEXADECIMAL CHARACTER.
  * @param chr:		Character to analyse.
  * @return status:	Function execution status.
@@ -114,23 +114,21 @@ errors:
 	return status;
 }
 
-/* CONVERTS A 4-BITS VARIABLE TO THE ASCII CODE OF THE CORRESPONDING HEXADECIMAL CHARACTER IN ASCII.
- * @param value:	Decimal digit.
- * @return chr:		Corresponding ASCII code.
+/* WRITE THE LAST DIGITS OF A 4-DIGITS DECIMAL CHUNK.
+ * @param chunk:			Chunk value (0 to 9999).
+ * @param number_of_digits:	Number of digits to write (1 to 4, leading zeros are written if needed).
+ * @param str_end:			Pointer to the character following the last digit to write.
+ * @return:					None.
  */
-static STRING_status_t _STRING_hexadecimal_value_to_char(uint8_t value, char_t* chr) {
+static void _STRING_write_decimal_chunk(uint32_t chunk, uint8_t number_of_digits, char_t* str_end) {
 	// Local variables.
-	STRING_status_t status = STRING_SUCCESS;
-	// Check parameters.
-	if (value > STRING_DIGIT_HEXADECIMAL_MAX) {
-		status = STRING_ERROR_HEXADECIMAL_OVERFLOW;
-		goto errors;
-	}
-	_STRING_check_pointer(chr);
-	// Perform conversion.
-	(*chr) = (value <= 9 ? (value + '0') : (value + ('A' - 10)));
-errors:
-	return status;
+	uint32_t high_pair = ((chunk * 5243) >> 19); // Equivalent to (chunk / 100) for chunk < 43699.
+	uint32_t low_pair = chunk - (high_pair * 100);
+	// Write digits from right to left.
+	*(--str_end) = STRING_DECIMAL_DIGIT_PAIRS[(2 * low_pair) + 1];
+	if (number_of_digits > 1) *(--str_end) = STRING_DECIMAL_DIGIT_PAIRS[(2 * low_pair)];
+	if (number_of_digits > 2) *(--str_end) = STRING_DECIMAL_DIGIT_PAIRS[(2 * high_pair) + 1];
+	if (number_of_digits > 3) *(--str_end) = STRING_DECIMAL_DIGIT_PAIRS[(2 * high_pair)];
 }
 
 /*** STRING functions ***/
@@ -150,9 +148,11 @@ STRING_status_t STRING_value_to_string(int32_t value, STRING_format_t format, ui
 	uint32_t str_idx = 0;
 	uint32_t idx = 0;
 	uint8_t generic_byte = 0;
-	uint32_t current_power = 0;
-	uint32_t previous_decade = 0;
+	uint8_t number_of_digits = 0;
+	uint32_t chunk = 0;
+	uint32_t high_chunks = 0;
 	uint32_t abs_value = 0;
+	PROF_enter(PROF_PROBE_STRING_VALUE_TO_STRING);
 	// Check parameters.
 	_STRING_check_pointer(str);
 	// Manage negative numbers.
@@ -196,11 +196,9 @@ STRING_status_t STRING_value_to_string(int32_t value, STRING_format_t format, ui
 				first_non_zero_found = 1;
 			}
 			if ((first_non_zero_found != 0) || (idx == 0)) {
-				// Convert to character.
-				status = _STRING_hexadecimal_value_to_char(((generic_byte & 0xF0) >> 4), &(str[str_idx++]));
-				if (status != STRING_SUCCESS) goto errors;
-				status = _STRING_hexadecimal_value_to_char(((generic_byte & 0x0F) >> 0), &(str[str_idx++]));
-				if (status != STRING_SUCCESS) goto errors;
+				// Convert both nibbles to characters.
+				str[str_idx++] = STRING_HEXADECIMAL_DIGITS[generic_byte >> 4];
+				str[str_idx++] = STRING_HEXADECIMAL_DIGITS[generic_byte & 0x0F];
 			}
 			if (idx == 0) break;
 		}
@@ -211,20 +209,27 @@ STRING_status_t STRING_value_to_string(int32_t value, STRING_format_t format, ui
 			str[str_idx++] = '0';
 			str[str_idx++] = 'd';
 		}
-		for (idx=(MATH_DECIMAL_MAX_SIZE - 1) ; idx>=0 ; idx--) {
-			math_status = MATH_pow_10(idx, &current_power);
-			MATH_status_check(STRING_ERROR_BASE_MATH);
-			generic_byte = (abs_value - previous_decade) / current_power;
-			previous_decade += generic_byte * current_power;
-			if (generic_byte != 0) {
-				first_non_zero_found = 1;
-			}
-			if ((first_non_zero_found != 0) || (idx == 0)) {
-				status = _STRING_decimal_value_to_char(generic_byte, &(str[str_idx++]));
-				if (status != STRING_SUCCESS) goto errors;
-			}
-			if (idx == 0) break;
+		// Compute number of digits.
+		number_of_digits = 1;
+		while ((number_of_digits < MATH_DECIMAL_MAX_SIZE) && (abs_value >= STRING_DECIMAL_THRESHOLDS[number_of_digits - 1])) {
+			number_of_digits++;
+		}
+		// Split value in 4-digits chunks without division.
+		high_chunks = (uint32_t) ((((uint64_t) abs_value) * 0xD1B71759) >> 45); // Equivalent to (abs_value / 10000).
+		chunk = abs_value - (high_chunks * 10000);
+		// Write digits from right to left.
+		str_idx += number_of_digits;
+		idx = str_idx;
+		while (number_of_digits > STRING_DECIMAL_DIGIT_PER_CHUNK) {
+			_STRING_write_decimal_chunk(chunk, STRING_DECIMAL_DIGIT_PER_CHUNK, &(str[idx]));
+			idx -= STRING_DECIMAL_DIGIT_PER_CHUNK;
+			number_of_digits -= STRING_DECIMAL_DIGIT_PER_CHUNK;
+			// Next chunk.
+			chunk = high_chunks;
+			high_chunks = ((high_chunks >> 4) * 6711) >> 22; // Equivalent to (high_chunks / 10000) for high_chunks < 429497.
+			chunk -= (high_chunks * 10000);
 		}
+		_STRING_write_decimal_chunk(chunk, number_of_digits, &(str[idx]));
 		break;
 	default:
 		status = STRING_ERROR_FORMAT;
@@ -232,6 +237,7 @@ STRING_status_t STRING_value_to_string(int32_t value, STRING_format_t format, ui
 	}
 errors:
 	str[str_idx++] = STRING_CHAR_NULL; // End string.
+	PROF_exit(PROF_PROBE_STRING_VALUE_TO_STRING);
 	return status;
 }
 
@@ -0,0 +1,49 @@
+/*
+ * bench.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+// Project headers must be included before system headers (types.h defines NULL without guard).
+#include "types.h"
+
+#include <stdio.h>
+#include <time.h>
+
+/*** BENCH macros ***/
+
+#define BENCH_RANDOM_SEED	0x12345678
+
+/*** BENCH functions ***/
+
+/* GET MONOTONIC TIME.
+ * @param:	None.
+ * @return:	Current time in nanoseconds.
+ */
+static inline uint64_t BENCH_get_time_ns(void) {
+	// Local variables.
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (((uint64_t) ts.tv_sec) * 1000000000ULL) + ((uint64_t) ts.tv_nsec);
+}
+
+/* PSEUDO RANDOM GENERATOR (XORSHIFT32).
+ * @param:	None.
+ * @return:	Next random value.
+ */
+static uint32_t bench_random_state = BENCH_RANDOM_SEED;
+static inline uint32_t BENCH_random(void) {
+	bench_random_state ^= (bench_random_state << 13);
+	bench_random_state ^= (bench_random_state >> 17);
+	bench_random_state ^= (bench_random_state << 5);
+	return bench_random_state;
+}
+
+// Sink used to prevent the compiler from removing benchmarked calls.
+static volatile uint32_t bench_sink = 0;
+
+#endif /* __BENCH_H__ */
@@ -0,0 +1,175 @@
+/*
+ * math_bench.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "math.h"
+#include "types.h"
+
+#include "bench.h"
+
+/*** MATH BENCH macros ***/
+
+#define MATH_BENCH_RANDOM_CASES			200000
+#define MATH_BENCH_LENGTH_MAX			63
+#define MATH_BENCH_ITERATIONS			1000000
+#define MATH_BENCH_DATA_SETS			256 // Must be a power of 2.
+
+/*** MATH BENCH local functions ***/
+
+/* REFERENCE MEDIAN FILTER (FORMER BUBBLE SORT KERNEL).
+ * @param data:				Input buffer.
+ * @param median_length:	Number of elements taken for median value search.
+ * @param average_length:	Number of center elements taken for final average.
+ * @param result:			Pointer that will contain the result.
+ * @return status:			Function execution status.
+ * Note: the average is computed over the sorted center elements, as the firmware does since the averaging source fix.
+ */
+#define _MATH_BENCH_reference(type, average_function) \
+static MATH_status_t _MATH_BENCH_reference_##type(type* data, uint8_t median_length, uint8_t average_length, type* result) { \
+	type local_buf[0xFF]; \
+	type temp = 0; \
+	uint8_t buffer_sorted = 0; \
+	uint8_t start_idx = 0; \
+	uint8_t end_idx = 0; \
+	uint8_t idx1 = 0; \
+	uint8_t idx2 = 0; \
+	for (idx1=0 ; idx1<median_length ; idx1++) { \
+		local_buf[idx1] = data[idx1]; \
+	} \
+	for (idx1=0; idx1<median_length; ++idx1) { \
+		buffer_sorted = 1; \
+		for (idx2=1 ; idx2<(median_length-idx1) ; ++idx2) { \
+			if (local_buf[idx2 - 1] > local_buf[idx2]) { \
+				temp = local_buf[idx2 - 1]; \
+				local_buf[idx2 - 1] = local_buf[idx2]; \
+				local_buf[idx2] = temp; \
+				buffer_sorted = 0; \
+			} \
+		} \
+		if (buffer_sorted != 0) break; \
+	} \
+	if (average_length > 0) { \
+		if (average_length > median_length) { \
+			average_length = median_length; \
+		} \
+		start_idx = (median_length / 2) - (average_length / 2); \
+		end_idx = (median_length / 2) + (average_length / 2); \
+		if (end_idx >= median_length) { \
+			end_idx = (median_length - 1); \
+		} \
+		return average_function(&(local_buf[start_idx]), (end_idx - start_idx + 1), result); \
+	} \
+	(*result) = local_buf[(median_length / 2)]; \
+	return MATH_SUCCESS; \
+}
+
+_MATH_BENCH_reference(uint8_t, MATH_average_u8)
+_MATH_BENCH_reference(uint16_t, MATH_average_u16)
+_MATH_BENCH_reference(uint32_t, MATH_average_u32)
+
+/* COMPARE FIRMWARE AND REFERENCE FILTERS ON RANDOM INPUTS.
+ * @param:	None.
+ * @return:	Number of mismatches.
+ */
+static uint32_t _MATH_BENCH_check(void) {
+	// Local variables.
+	uint8_t data_u8[MATH_BENCH_LENGTH_MAX];
+	uint16_t data_u16[MATH_BENCH_LENGTH_MAX];
+	uint32_t data_u32[MATH_BENCH_LENGTH_MAX];
+	uint8_t result_u8[2];
+	uint16_t result_u16[2];
+	uint32_t result_u32[2];
+	uint32_t mismatches = 0;
+	uint32_t value_mask = 0;
+	uint32_t idx = 0;
+	uint8_t median_length = 0;
+	uint8_t average_length = 0;
+	uint8_t data_idx = 0;
+	for (idx=0 ; idx<MATH_BENCH_RANDOM_CASES ; idx++) {
+		median_length = (uint8_t) (1 + (BENCH_random() % MATH_BENCH_LENGTH_MAX));
+		average_length = (uint8_t) (BENCH_random() % (median_length + 2));
+		// Narrow value ranges regularly to get many duplicates.
+		value_mask = ((idx & 0x3) == 0) ? 0x7 : 0xFFFFFFFF;
+		for (data_idx=0 ; data_idx<median_length ; data_idx++) {
+			data_u32[data_idx] = (BENCH_random() & value_mask);
+			data_u16[data_idx] = (uint16_t) data_u32[data_idx];
+			data_u8[data_idx] = (uint8_t) data_u32[data_idx];
+		}
+		MATH_median_filter_u8(data_u8, median_length, average_length, &result_u8[0]);
+		_MATH_BENCH_reference_uint8_t(data_u8, median_length, average_length, &result_u8[1]);
+		MATH_median_filter_u16(data_u16, median_length, average_length, &result_u16[0]);
+		_MATH_BENCH_reference_uint16_t(data_u16, median_length, average_length, &result_u16[1]);
+		MATH_median_filter_u32(data_u32, median_length, average_length, &result_u32[0]);
+		_MATH_BENCH_reference_uint32_t(data_u32, median_length, average_length, &result_u32[1]);
+		if ((result_u8[0] != result_u8[1]) || (result_u16[0] != result_u16[1]) || (result_u32[0] != result_u32[1])) {
+			if (mismatches < 10) {
+				printf("Mismatch: median_length=%u average_length=%u\n", median_length, average_length);
+			}
+			mismatches++;
+		}
+	}
+	return mismatches;
+}
+
+/* MEASURE FIRMWARE AND REFERENCE FILTERS DURATION.
+ * @param median_length:	Filter size.
+ * @param average_length:	Number of center elements taken for final average.
+ * @return:					None.
+ */
+static void _MATH_BENCH_measure(uint8_t median_length, uint8_t average_length) {
+	// Local variables.
+	static uint32_t data[MATH_BENCH_DATA_SETS][MATH_BENCH_LENGTH_MAX];
+	uint32_t result = 0;
+	uint64_t start_ns = 0;
+	uint64_t reference_ns = 0;
+	uint64_t firmware_ns = 0;
+	uint32_t idx = 0;
+	uint32_t data_idx = 0;
+	// Build data sets (12-bits ADC like samples).
+	for (idx=0 ; idx<MATH_BENCH_DATA_SETS ; idx++) {
+		for (data_idx=0 ; data_idx<median_length ; data_idx++) {
+			data[idx][data_idx] = (BENCH_random() & 0xFFF);
+		}
+	}
+	// Reference kernel.
+	start_ns = BENCH_get_time_ns();
+	for (idx=0 ; idx<MATH_BENCH_ITERATIONS ; idx++) {
+		_MATH_BENCH_reference_uint32_t(data[idx & (MATH_BENCH_DATA_SETS - 1)], median_length, average_length, &result);
+		bench_sink += result;
+	}
+	reference_ns = BENCH_get_time_ns() - start_ns;
+	// Firmware kernel.
+	start_ns = BENCH_get_time_ns();
+	for (idx=0 ; idx<MATH_BENCH_ITERATIONS ; idx++) {
+		MATH_median_filter_u32(data[idx & (MATH_BENCH_DATA_SETS - 1)], median_length, average_length, &result);
+		bench_sink += result;
+	}
+	firmware_ns = BENCH_get_time_ns() - start_ns;
+	printf("median_length=%2u average_length=%u : bubble sort %7.1f ns, firmware %7.1f ns, speed-up x%.2f\n",
+		median_length, average_length,
+		((double) reference_ns) / MATH_BENCH_ITERATIONS,
+		((double) firmware_ns) / MATH_BENCH_ITERATIONS,
+		((double) reference_ns) / ((double) firmware_ns));
+}
+
+/*** MATH BENCH main function ***/
+
+int main(void) {
+	// Local variables.
+	uint32_t mismatches = 0;
+	// Bit identity check.
+	mismatches = _MATH_BENCH_check();
+	printf("Median filters: %u random cases, %u mismatch(es) against bubble sort reference\n", MATH_BENCH_RANDOM_CASES, mismatches);
+	// Duration measurements (ADC driver uses 9 samples and 3 center samples).
+	_MATH_BENCH_measure(3, 0);
+	_MATH_BENCH_measure(5, 0);
+	_MATH_BENCH_measure(9, 0);
+	_MATH_BENCH_measure(9, 3);
+	_MATH_BENCH_measure(15, 3);
+	_MATH_BENCH_measure(31, 5);
+	_MATH_BENCH_measure(63, 5);
+	return (mismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,21 @@
+/*
+ * rcc_reg.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SIM_RCC_REG_H__
+#define __SIM_RCC_REG_H__
+
+#include "../../inc/registers/rcc_reg.h"
+
+/*** RCC simulated registers ***/
+
+// Registers are mapped on a host variable instead of the peripheral address.
+extern RCC_base_address_t sim_rcc;
+
+#undef RCC
+#define RCC		(&sim_rcc)
+
+#endif /* __SIM_RCC_REG_H__ */
@@ -0,0 +1,372 @@
+/*
+ * sim.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "sim.h"
+
+#include "dinfox.h"
+#include "lpuart.h"
+#include "rs485_common.h"
+#include "string.h"
+#include "types.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*** SIM local macros ***/
+
+#define SIM_EVENTS_MAX				128
+#define SIM_RANDOM_SEED				0x12345678
+#define SIM_NODE_READ_HEADER		"RS$R="
+#define SIM_NODE_PING				"RS"
+
+/*** SIM local structures ***/
+
+typedef struct {
+	uint64_t time_us;
+	SIM_callback_t callback;
+	uint8_t data[SIM_FRAME_SIZE_MAX];
+	uint8_t data_size;
+} SIM_event_t;
+
+typedef struct {
+	RS485_address_t source_address;
+	RS485_address_t destination_address;
+	uint32_t period_ms;
+	uint32_t count;
+	char_t data[SIM_FRAME_SIZE_MAX];
+} SIM_traffic_t;
+
+typedef struct {
+	// Virtual clock.
+	uint64_t time_us;
+	uint64_t timer_us;
+	// Pending interrupts.
+	SIM_event_t events[SIM_EVENTS_MAX];
+	uint8_t events_count;
+	// Virtual nodes.
+	SIM_node_t nodes[SIM_NODES_MAX];
+	uint8_t nodes_count;
+	uint32_t random_state;
+	// Unsolicited frames.
+	SIM_traffic_t traffic[SIM_TRAFFIC_MAX];
+	uint8_t traffic_count;
+	// DIM receiver.
+	SIM_callback_t receive_callback;
+} SIM_context_t;
+
+/*** SIM local global variables ***/
+
+static SIM_context_t sim_ctx = {.timer_us = SIM_TIME_INFINITE, .random_state = SIM_RANDOM_SEED};
+
+/*** SIM local functions ***/
+
+static void _SIM_traffic_frame(uint8_t* data, uint8_t data_size);
+
+/* PSEUDO RANDOM GENERATOR (XORSHIFT32).
+ * @param:	None.
+ * @return:	Next random value.
+ */
+static uint32_t _SIM_random(void) {
+	sim_ctx.random_state ^= (sim_ctx.random_state << 13);
+	sim_ctx.random_state ^= (sim_ctx.random_state >> 17);
+	sim_ctx.random_state ^= (sim_ctx.random_state << 5);
+	return sim_ctx.random_state;
+}
+
+/* SCHEDULE THE NEXT FRAME OF AN UNSOLICITED TRAFFIC.
+ * @param traffic_idx:	Traffic index.
+ * @param start_us:		Time at which the frame transmission starts.
+ * @return:				None.
+ */
+static void _SIM_schedule_traffic_frame(uint8_t traffic_idx, uint64_t start_us) {
+	// Local variables.
+	SIM_traffic_t* traffic = &(sim_ctx.traffic[traffic_idx]);
+	uint32_t frame_size = RS485_FRAME_FIELD_INDEX_DATA + strlen(traffic -> data) + 1;
+	// Frame is available once its last byte has been received.
+	SIM_schedule(start_us + SIM_get_frame_time_us(frame_size, LPUART1_get_baud_rate()), &_SIM_traffic_frame, &traffic_idx, 1);
+}
+
+/* UNSOLICITED TRAFFIC FRAME RECEPTION.
+ * @param data:			Traffic index.
+ * @param data_size:	Unused.
+ * @return:				None.
+ */
+static void _SIM_traffic_frame(uint8_t* data, uint8_t data_size) {
+	// Local variables.
+	SIM_traffic_t* traffic = &(sim_ctx.traffic[data[0]]);
+	uint8_t frame[SIM_FRAME_SIZE_MAX];
+	uint8_t frame_size = 0;
+	// Build frame.
+	frame[frame_size++] = ((traffic -> destination_address) | 0x80);
+	frame[frame_size++] = (traffic -> source_address);
+	memcpy(&(frame[frame_size]), (traffic -> data), strlen(traffic -> data));
+	frame_size += strlen(traffic -> data);
+	frame[frame_size++] = RS485_FRAME_END;
+	if (sim_ctx.receive_callback != NULL) {
+		sim_ctx.receive_callback(frame, frame_size);
+	}
+	// Next frame.
+	(traffic -> count)--;
+	if ((traffic -> count) != 0) {
+		_SIM_schedule_traffic_frame(data[0], SIM_get_time_us() + ((uint64_t) (traffic -> period_ms) * 1000) - SIM_get_frame_time_us(frame_size, LPUART1_get_baud_rate()));
+	}
+}
+
+/* EXECUTE THE NEXT PENDING INTERRUPT IF IT OCCURS BEFORE A DEADLINE.
+ * @param deadline_us:	Time limit.
+ * @return:				1 if an interrupt has been executed, 0 otherwise (the clock is then set to the deadline).
+ */
+static uint8_t _SIM_run_next_event(uint64_t deadline_us) {
+	// Local variables.
+	SIM_event_t event;
+	uint8_t next_idx = 0;
+	uint8_t idx = 0;
+	// Search earliest event (the first one wins in case of equality so that order is kept).
+	for (idx=1 ; idx<sim_ctx.events_count ; idx++) {
+		if (sim_ctx.events[idx].time_us < sim_ctx.events[next_idx].time_us) {
+			next_idx = idx;
+		}
+	}
+	if ((sim_ctx.events_count == 0) || (sim_ctx.events[next_idx].time_us > deadline_us)) {
+		if ((deadline_us != SIM_TIME_INFINITE) && (deadline_us > sim_ctx.time_us)) {
+			sim_ctx.time_us = deadline_us;
+		}
+		return 0;
+	}
+	// Remove event from queue before executing it since the callback may schedule new ones.
+	event = sim_ctx.events[next_idx];
+	for (idx=next_idx ; idx<(sim_ctx.events_count - 1) ; idx++) {
+		sim_ctx.events[idx] = sim_ctx.events[idx + 1];
+	}
+	sim_ctx.events_count--;
+	// Execute interrupt.
+	if (event.time_us > sim_ctx.time_us) {
+		sim_ctx.time_us = event.time_us;
+	}
+	event.callback(event.data, event.data_size);
+	return 1;
+}
+
+/* BUILD THE REPLY OF A VIRTUAL NODE.
+ * @param node:		Virtual node.
+ * @param command:	Received command (null terminated, without address header and end character).
+ * @param reply:	Buffer that will contain the reply string.
+ * @return:			None.
+ */
+static void _SIM_node_reply(SIM_node_t* node, char_t* command, char_t* reply) {
+	// Local variables.
+	uint32_t register_address = 0;
+	uint32_t register_value = 0;
+	// Decode command.
+	if (strcmp(command, SIM_NODE_PING) == 0) {
+		strcpy(reply, "OK");
+	}
+	else if ((strncmp(command, SIM_NODE_READ_HEADER, strlen(SIM_NODE_READ_HEADER)) == 0) && (sscanf(&(command[strlen(SIM_NODE_READ_HEADER)]), "%2x", &register_address) == 1) && (register_address < DINFOX_REGISTER_LAST)) {
+		// Common registers (only the identification ones have a relevant value).
+		switch (register_address) {
+		case DINFOX_REGISTER_RS485_ADDRESS:
+			register_value = (node -> address);
+			break;
+		case DINFOX_REGISTER_BOARD_ID:
+			register_value = (node -> board_id);
+			break;
+		default:
+			register_value = 0;
+			break;
+		}
+		sprintf(reply, "%02X", register_value);
+	}
+	else {
+		strcpy(reply, "ERROR");
+	}
+}
+
+/*** SIM functions ***/
+
+/* GET VIRTUAL TIME.
+ * @param:	None.
+ * @return:	Time since simulation start in microseconds.
+ */
+uint64_t SIM_get_time_us(void) {
+	return sim_ctx.time_us;
+}
+
+/* SCHEDULE AN INTERRUPT.
+ * @param time_us:		Interrupt time.
+ * @param callback:		Function executed at interrupt time.
+ * @param data:			Data given to the callback (copied).
+ * @param data_size:	Size of the data.
+ * @return:				None.
+ */
+void SIM_schedule(uint64_t time_us, SIM_callback_t callback, uint8_t* data, uint8_t data_size) {
+	// Local variables.
+	SIM_event_t* event = &(sim_ctx.events[sim_ctx.events_count]);
+	// Check queue.
+	if ((sim_ctx.events_count >= SIM_EVENTS_MAX) || (data_size > SIM_FRAME_SIZE_MAX)) {
+		printf("SIM: interrupt queue overflow\n");
+		return;
+	}
+	(event -> time_us) = time_us;
+	(event -> callback) = callback;
+	(event -> data_size) = data_size;
+	if (data_size != 0) {
+		memcpy(event -> data, data, data_size);
+	}
+	sim_ctx.events_count++;
+}
+
+/* SET WAKE-UP TIMER.
+ * @param time_us:	Timer expiration time (SIM_TIME_INFINITE to stop the timer).
+ * @return:			None.
+ */
+void SIM_set_timer(uint64_t time_us) {
+	sim_ctx.timer_us = time_us;
+}
+
+/* WAIT FOR THE NEXT INTERRUPT (WFI INSTRUCTION).
+ * @param:	None.
+ * @return:	None.
+ * Note: the clock jumps to the next interrupt or timer expiration, since processing time is not simulated.
+ */
+void SIM_wait_for_interrupt(void) {
+	// Timer expiration also wakes the core up.
+	if ((_SIM_run_next_event(sim_ctx.timer_us) == 0) && (sim_ctx.timer_us == SIM_TIME_INFINITE)) {
+		printf("SIM: core sleeping without wake-up source\n");
+	}
+}
+
+/* EXECUTE THE NEXT INTERRUPT IF IT OCCURS BEFORE A DEADLINE (MAIN LOOP WAKE-UP).
+ * @param deadline_us:	Time limit.
+ * @return:				1 if an interrupt has been executed, 0 otherwise (the clock is then set to the deadline).
+ */
+uint8_t SIM_run_next_event(uint64_t deadline_us) {
+	return _SIM_run_next_event(deadline_us);
+}
+
+/* RUN ALL INTERRUPTS UNTIL A GIVEN TIME (LOW POWER DELAY).
+ * @param time_us:	End time.
+ * @return:			None.
+ */
+void SIM_run_until(uint64_t time_us) {
+	while (_SIM_run_next_event(time_us) != 0);
+}
+
+/* COMPUTE THE DURATION OF A FRAME ON THE WIRE.
+ * @param frame_size:	Number of bytes.
+ * @param baud_rate:	Bus baud rate.
+ * @return:				Frame duration in microseconds (10 bits per byte).
+ */
+uint32_t SIM_get_frame_time_us(uint32_t frame_size, uint32_t baud_rate) {
+	return (uint32_t) ((((uint64_t) frame_size) * 10 * 1000000) / baud_rate);
+}
+
+/* ATTACH THE DIM RECEIVER TO THE VIRTUAL BUS.
+ * @param receive_callback:	Function called with each frame sent to the DIM when it has been fully received.
+ * @return:					None.
+ */
+void SIM_attach_receiver(SIM_callback_t receive_callback) {
+	sim_ctx.receive_callback = receive_callback;
+}
+
+/* ADD A VIRTUAL NODE ON THE BUS.
+ * @param address:		Node address.
+ * @param board_id:		Board identifier returned in the board ID register.
+ * @param latency_ms:	Node turnaround time.
+ * @param jitter_ms:	Maximum random delay added to the turnaround time.
+ * @return:				1 on success, 0 if the node table is full.
+ */
+uint8_t SIM_add_node(RS485_address_t address, uint8_t board_id, uint32_t latency_ms, uint32_t jitter_ms) {
+	// Local variables.
+	SIM_node_t* node = &(sim_ctx.nodes[sim_ctx.nodes_count]);
+	// Check table.
+	if (sim_ctx.nodes_count >= SIM_NODES_MAX) return 0;
+	(node -> address) = (address & RS485_ADDRESS_MASK);
+	(node -> board_id) = board_id;
+	(node -> latency_ms) = latency_ms;
+	(node -> jitter_ms) = jitter_ms;
+	(node -> commands) = 0;
+	sim_ctx.nodes_count++;
+	return 1;
+}
+
+/* ADD AN UNSOLICITED PERIODIC TRAFFIC ON THE BUS.
+ * @param source_address:		Address of the sending node.
+ * @param destination_address:	Address of the destination node (the DIM only receives frames sent to its address in addressed mode).
+ * @param period_ms:			Frames period.
+ * @param count:				Number of frames.
+ * @param data:					Frame data (null terminated, without address header and end character).
+ * @return:						1 on success, 0 if the traffic table is full or if the parameters are invalid.
+ * Note: the first frame starts immediately, collisions with the DIM transmissions are not simulated.
+ */
+uint8_t SIM_add_traffic(RS485_address_t source_address, RS485_address_t destination_address, uint32_t period_ms, uint32_t count, char_t* data) {
+	// Local variables.
+	SIM_traffic_t* traffic = &(sim_ctx.traffic[sim_ctx.traffic_count]);
+	// Check parameters.
+	if ((sim_ctx.traffic_count >= SIM_TRAFFIC_MAX) || (period_ms == 0) || (count == 0) || ((RS485_FRAME_FIELD_INDEX_DATA + strlen(data) + 1) > SIM_FRAME_SIZE_MAX)) return 0;
+	(traffic -> source_address) = (source_address & RS485_ADDRESS_MASK);
+	(traffic -> destination_address) = (destination_address & RS485_ADDRESS_MASK);
+	(traffic -> period_ms) = period_ms;
+	(traffic -> count) = count;
+	strcpy((traffic -> data), data);
+	_SIM_schedule_traffic_frame(sim_ctx.traffic_count, SIM_get_time_us());
+	sim_ctx.traffic_count++;
+	return 1;
+}
+
+/* TRANSMIT A FRAME ON THE VIRTUAL BUS.
+ * @param frame:			Frame bytes (address header, command and end character).
+ * @param frame_size:		Size of the frame.
+ * @param end_time_us:		Time at which the last byte is on the wire.
+ * @param baud_rate:		Bus baud rate.
+ * @return:					None.
+ * Note: virtual nodes only answer addressed frames, as DINFox nodes do.
+ */
+void SIM_transmit(uint8_t* frame, uint8_t frame_size, uint64_t end_time_us, uint32_t baud_rate) {
+	// Local variables.
+	SIM_node_t* node = NULL;
+	char_t command[SIM_FRAME_SIZE_MAX];
+	char_t reply_data[SIM_FRAME_SIZE_MAX];
+	uint8_t reply[SIM_FRAME_SIZE_MAX];
+	uint8_t reply_size = 0;
+	uint64_t reply_time_us = 0;
+	uint8_t idx = 0;
+	// Check header and end character.
+	if ((frame_size <= RS485_FRAME_FIELD_INDEX_DATA) || ((frame[RS485_FRAME_FIELD_INDEX_DESTINATION_ADDRESS] & 0x80) == 0) || (frame[frame_size - 1] != RS485_FRAME_END)) return;
+	memcpy(command, &(frame[RS485_FRAME_FIELD_INDEX_DATA]), frame_size - RS485_FRAME_FIELD_INDEX_DATA - 1);
+	command[frame_size - RS485_FRAME_FIELD_INDEX_DATA - 1] = STRING_CHAR_NULL;
+	// Search destination node.
+	for (idx=0 ; idx<sim_ctx.nodes_count ; idx++) {
+		node = &(sim_ctx.nodes[idx]);
+		if ((node -> address) != (frame[RS485_FRAME_FIELD_INDEX_DESTINATION_ADDRESS] & RS485_ADDRESS_MASK)) continue;
+		(node -> commands)++;
+		// Build reply frame.
+		_SIM_node_reply(node, command, reply_data);
+		reply[RS485_FRAME_FIELD_INDEX_DESTINATION_ADDRESS] = (frame[RS485_FRAME_FIELD_INDEX_SOURCE_ADDRESS] | 0x80);
+		reply[RS485_FRAME_FIELD_INDEX_SOURCE_ADDRESS] = (node -> address);
+		reply_size = RS485_FRAME_FIELD_INDEX_DATA;
+		memcpy(&(reply[reply_size]), reply_data, strlen(reply_data));
+		reply_size += strlen(reply_data);
+		reply[reply_size++] = RS485_FRAME_END;
+		// Reply is available once its last byte has been received.
+		reply_time_us = end_time_us + ((uint64_t) (node -> latency_ms) * 1000);
+		if ((node -> jitter_ms) != 0) {
+			reply_time_us += (_SIM_random() % ((node -> jitter_ms) * 1000 + 1));
+		}
+		reply_time_us += SIM_get_frame_time_us(reply_size, baud_rate);
+		if (sim_ctx.receive_callback != NULL) {
+			SIM_schedule(reply_time_us, sim_ctx.receive_callback, reply, reply_size);
+		}
+	}
+}
+
+/* GET A VIRTUAL NODE.
+ * @param node_idx:	Node index.
+ * @return:			Pointer to the node, NULL if the index is out of range.
+ */
+SIM_node_t* SIM_get_node(uint8_t node_idx) {
+	return (node_idx < sim_ctx.nodes_count) ? &(sim_ctx.nodes[node_idx]) : NULL;
+}
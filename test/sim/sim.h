@@ -0,0 +1,59 @@
+/*
+ * sim.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SIM_H__
+#define __SIM_H__
+
+#include "rs485_common.h"
+#include "types.h"
+
+/*** SIM macros ***/
+
+#define SIM_TIME_INFINITE		0xFFFFFFFFFFFFFFFFULL
+#define SIM_FRAME_SIZE_MAX		128
+#define SIM_NODES_MAX			16
+#define SIM_TRAFFIC_MAX			4
+#define SIM_USART_TX_BUFFER_SIZE	512 // Same as the firmware host TX FIFO.
+
+/*** SIM structures ***/
+
+typedef void (*SIM_callback_t)(uint8_t* data, uint8_t data_size);
+
+typedef struct {
+	RS485_address_t address;
+	uint8_t board_id;
+	uint32_t latency_ms; // Turnaround time between the end of the command and the start of the reply.
+	uint32_t jitter_ms; // Maximum random delay added to the latency.
+	uint32_t commands;
+} SIM_node_t;
+
+typedef struct {
+	uint32_t rx_frames; // Frames given to the RS485 layer.
+	uint32_t rx_lost_frames; // Frames sent to the DIM while its receiver was disabled.
+} SIM_bus_statistics_t;
+
+/*** SIM functions ***/
+
+// Virtual clock and interrupts.
+uint64_t SIM_get_time_us(void);
+void SIM_schedule(uint64_t time_us, SIM_callback_t callback, uint8_t* data, uint8_t data_size);
+void SIM_set_timer(uint64_t time_us);
+uint8_t SIM_run_next_event(uint64_t deadline_us);
+void SIM_wait_for_interrupt(void);
+void SIM_run_until(uint64_t time_us);
+uint32_t SIM_get_frame_time_us(uint32_t frame_size, uint32_t baud_rate);
+// Virtual RS485 bus.
+void SIM_attach_receiver(SIM_callback_t receive_callback);
+uint8_t SIM_add_node(RS485_address_t address, uint8_t board_id, uint32_t latency_ms, uint32_t jitter_ms);
+uint8_t SIM_add_traffic(RS485_address_t source_address, RS485_address_t destination_address, uint32_t period_ms, uint32_t count, char_t* data);
+void SIM_transmit(uint8_t* frame, uint8_t frame_size, uint64_t end_time_us, uint32_t baud_rate);
+SIM_node_t* SIM_get_node(uint8_t node_idx);
+// Simulated peripherals.
+void SIM_get_bus_statistics(SIM_bus_statistics_t* statistics);
+void SIM_set_host_output(uint8_t enabled);
+
+#endif /* __SIM_H__ */
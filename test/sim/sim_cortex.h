@@ -0,0 +1,19 @@
+/*
+ * sim_cortex.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SIM_CORTEX_H__
+#define __SIM_CORTEX_H__
+
+// Included before every firmware source of the simulation build.
+// Cortex-M0+ instructions (interrupts masking) are turned into host assembler comments: the simulation is single threaded and
+// interrupt handlers are only executed from PWR_enter_sleep_mode() and LPTIM1_delay_milliseconds().
+// Operands are kept so that the PRIMASK save variables are still written and read by the compiler.
+// Only the "__asm volatile (...)" statement is matched: the volatile qualifier is never followed by a parenthesis.
+#define __asm
+#define volatile(...)	__asm__ __volatile__ ("# " __VA_ARGS__)
+
+#endif /* __SIM_CORTEX_H__ */
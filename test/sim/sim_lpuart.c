@@ -0,0 +1,230 @@
+/*
+ * sim_lpuart.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "lpuart.h"
+
+#include "rs485.h"
+#include "rs485_common.h"
+#include "sim.h"
+#include "string.h"
+#include "types.h"
+
+/*** LPUART local macros ***/
+
+#define LPUART_BAUD_RATE_DEFAULT	9600
+
+/*** LPUART local structures ***/
+
+typedef struct {
+	RS485_address_t node_address;
+	RS485_mode_t mode;
+	uint32_t baud_rate;
+	uint8_t rx_enabled;
+	uint8_t tx_running;
+	uint64_t tx_end_time_us;
+	SIM_bus_statistics_t statistics;
+} LPUART_context_t;
+
+/*** LPUART local global variables ***/
+
+static LPUART_context_t lpuart_ctx;
+
+/*** LPUART local functions ***/
+
+/* TC INTERRUPT.
+ * @param data:			Unused.
+ * @param data_size:	Unused.
+ * @return:				None.
+ */
+static void _LPUART1_tx_complete(uint8_t* data, uint8_t data_size) {
+	lpuart_ctx.tx_running = 0;
+	RS485_tx_complete();
+}
+
+/* IDLE LINE INTERRUPT.
+ * @param data:			Frame received on the bus.
+ * @param data_size:	Size of the frame.
+ * @return:				None.
+ * Note: like the hardware, bytes are lost while the receiver is disabled and frames sent to other addresses are filtered by mute mode.
+ */
+static void _LPUART1_receive_frame(uint8_t* data, uint8_t data_size) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Check address and receiver state.
+	if ((lpuart_ctx.mode == RS485_MODE_ADDRESSED) && ((data[RS485_FRAME_FIELD_INDEX_DESTINATION_ADDRESS] & RS485_ADDRESS_MASK) != lpuart_ctx.node_address)) return;
+	if (lpuart_ctx.rx_enabled == 0) {
+		lpuart_ctx.statistics.rx_lost_frames++;
+		return;
+	}
+	// Forward bytes to the RS485 layer.
+	lpuart_ctx.statistics.rx_frames++;
+	for (idx=0 ; idx<data_size ; idx++) {
+		RS485_fill_rx_buffer(data[idx]);
+	}
+}
+
+/*** LPUART functions ***/
+
+/* CONFIGURE LPUART1.
+ * @param node_address:	RS485 7-bits address
+ * @return status:		Function execution status.
+ */
+LPUART_status_t LPUART1_init(RS485_address_t node_address) {
+	// Local variables.
+	LPUART_status_t status = LPUART_SUCCESS;
+	// Check parameter.
+	if (node_address > RS485_ADDRESS_LAST) {
+		status = LPUART_ERROR_NODE_ADDRESS;
+		goto errors;
+	}
+	lpuart_ctx.node_address = node_address;
+	lpuart_ctx.mode = RS485_MODE_DIRECT;
+	lpuart_ctx.baud_rate = LPUART_BAUD_RATE_DEFAULT;
+	lpuart_ctx.rx_enabled = 0;
+	lpuart_ctx.tx_running = 0;
+	lpuart_ctx.tx_end_time_us = 0;
+	SIM_attach_receiver(&_LPUART1_receive_frame);
+errors:
+	return status;
+}
+
+/* CONFIGURE LPUART1 MODE.
+ * @param mode:		RS485 mode.
+ * @return status:	Function execution status.
+ */
+LPUART_status_t LPUART1_set_mode(RS485_mode_t mode) {
+	// Local variables.
+	LPUART_status_t status = LPUART_SUCCESS;
+	// Check parameter.
+	if (mode >= RS485_MODE_LAST) {
+		status = LPUART_ERROR_MODE;
+		goto errors;
+	}
+	lpuart_ctx.mode = mode;
+errors:
+	return status;
+}
+
+/* SET LPUART1 BAUD RATE.
+ * @param baud_rate:	New baud rate.
+ * @return status:		Function execution status.
+ */
+LPUART_status_t LPUART1_set_baud_rate(uint32_t baud_rate) {
+	// Local variables.
+	LPUART_status_t status = LPUART_SUCCESS;
+	// Check parameter.
+	if (baud_rate == 0) {
+		status = LPUART_ERROR_BAUD_RATE;
+		goto errors;
+	}
+	lpuart_ctx.baud_rate = baud_rate;
+errors:
+	return status;
+}
+
+/* EANABLE LPUART RX OPERATION.
+ * @param:	None.
+ * @return:	None.
+ */
+void LPUART1_enable_rx(void) {
+	lpuart_ctx.rx_enabled = 1;
+}
+
+/* DISABLE LPUART RX OPERATION.
+ * @param:	None.
+ * @return:	None.
+ */
+void LPUART1_disable_rx(void) {
+	lpuart_ctx.rx_enabled = 0;
+}
+
+/* SEND A COMMAND TO AN RS485 NODE.
+ * @param slave_address:	RS485 address of the destination board.
+ * @param command:			Command to send.
+ * @return status:			Function execution status.
+ * Note: the frame is put on the virtual bus after the previous one, TC interrupt occurs when its last byte has been sent.
+ */
+LPUART_status_t LPUART1_send_command(RS485_address_t slave_address, char_t* command) {
+	// Local variables.
+	LPUART_status_t status = LPUART_SUCCESS;
+	uint8_t frame[SIM_FRAME_SIZE_MAX];
+	uint8_t frame_size = 0;
+	uint32_t idx = 0;
+	// Check parameters.
+	if (command == NULL) {
+		status = LPUART_ERROR_NULL_PARAMETER;
+		goto errors;
+	}
+	if (slave_address > RS485_ADDRESS_LAST) {
+		status = LPUART_ERROR_NODE_ADDRESS;
+		goto errors;
+	}
+	// Build frame.
+	if (lpuart_ctx.mode == RS485_MODE_ADDRESSED) {
+		frame[frame_size++] = (slave_address | 0x80);
+		frame[frame_size++] = lpuart_ctx.node_address;
+	}
+	for (idx=0 ; command[idx] != STRING_CHAR_NULL ; idx++) {
+		if (frame_size >= SIM_FRAME_SIZE_MAX) {
+			status = LPUART_ERROR_TX_BUFFER_FULL;
+			goto errors;
+		}
+		frame[frame_size++] = (uint8_t) command[idx];
+	}
+	// Start transmission.
+	if ((lpuart_ctx.tx_running == 0) || (lpuart_ctx.tx_end_time_us < SIM_get_time_us())) {
+		lpuart_ctx.tx_end_time_us = SIM_get_time_us();
+	}
+	lpuart_ctx.tx_end_time_us += SIM_get_frame_time_us(frame_size, lpuart_ctx.baud_rate);
+	lpuart_ctx.tx_running = 1;
+	SIM_schedule(lpuart_ctx.tx_end_time_us, &_LPUART1_tx_complete, NULL, 0);
+	SIM_transmit(frame, frame_size, lpuart_ctx.tx_end_time_us, lpuart_ctx.baud_rate);
+errors:
+	return status;
+}
+
+/* CHECK IF A TRANSMISSION IS RUNNING.
+ * @param:	None.
+ * @return:	1 if bytes are being sent, 0 otherwise.
+ */
+uint8_t LPUART1_is_tx_running(void) {
+	return lpuart_ctx.tx_running;
+}
+
+/* GET LPUART1 BAUD RATE.
+ * @param:	None.
+ * @return:	Current baud rate.
+ */
+uint32_t LPUART1_get_baud_rate(void) {
+	return lpuart_ctx.baud_rate;
+}
+
+/* GET NUMBER OF RX OVERRUNS.
+ * @param:	None.
+ * @return:	Always 0 (reception is not byte-timed in simulation).
+ */
+uint32_t LPUART1_get_rx_overruns(void) {
+	return 0;
+}
+
+/* RESET RX OVERRUNS COUNTER.
+ * @param:	None.
+ * @return:	None.
+ */
+void LPUART1_reset_rx_overruns(void) {
+	// Nothing to do.
+}
+
+/*** SIM LPUART functions ***/
+
+/* GET VIRTUAL BUS RECEPTION STATISTICS.
+ * @param statistics:	Pointer that will contain the frames received and lost by the DIM since start.
+ * @return:				None.
+ */
+void SIM_get_bus_statistics(SIM_bus_statistics_t* statistics) {
+	(*statistics) = lpuart_ctx.statistics;
+}
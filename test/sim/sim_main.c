@@ -0,0 +1,262 @@
+/*
+ * sim_main.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "at.h"
+#include "config.h"
+#include "dinfox.h"
+#include "error.h"
+#include "event.h"
+#include "lpuart.h"
+#include "mode.h"
+#include "nvm.h"
+#include "prof.h"
+#include "rs485.h"
+#include "sim.h"
+#include "types.h"
+#include "usart.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*** SIM MAIN local macros ***/
+
+#define SIM_MAIN_LINE_SIZE_MAX		128
+#define SIM_MAIN_MASTER_ADDRESS		0x00
+#define SIM_MAIN_COMMENT			'#'
+#define SIM_MAIN_DIRECTIVE_NODE		"@node"
+#define SIM_MAIN_DIRECTIVE_WAIT		"@wait"
+#define SIM_MAIN_DIRECTIVE_TRAFFIC	"@traffic"
+#define SIM_MAIN_DIRECTIVE_RATE		"@rate"
+
+/*** SIM MAIN local functions ***/
+
+/* RUN FIRMWARE TASKS UNTIL NO EVENT IS PENDING.
+ * @param:	None.
+ * @return:	None.
+ * Note: same dispatch as the firmware main loop, the core would then enter stop mode until the next host command.
+ */
+static void _SIM_MAIN_process_events(void) {
+	while (EVENT_is_pending() != 0) {
+		// Host interface.
+		if (EVENT_take(EVENT_HOST_RX) != 0) {
+			AT_task();
+		}
+		// Bus sniffer.
+		if (EVENT_take(EVENT_RS485_RX) != 0) {
+			RS485_task();
+		}
+		// Periodic tasks (RTC wake-up is not simulated).
+		EVENT_take(EVENT_RTC_WAKEUP);
+		// Resumable scan.
+		if (EVENT_take(EVENT_NODE_SCAN) != 0) {
+			AT_scan_task();
+		}
+	}
+}
+
+/* RUN THE FIRMWARE MAIN LOOP UNTIL A GIVEN TIME.
+ * @param time_us:	End time.
+ * @return:			None.
+ * Note: pending events are processed after each interrupt, then the core sleeps until the next one.
+ */
+static void _SIM_MAIN_run_until(uint64_t time_us) {
+	do {
+		_SIM_MAIN_process_events();
+	}
+	while (SIM_run_next_event(time_us) != 0);
+}
+
+/* SEND A LINE THROUGH THE HOST INTERFACE.
+ * @param line:	Line to send (without end of line).
+ * @return:		None.
+ */
+static void _SIM_MAIN_send_line(char_t* line) {
+	// Local variables.
+	uint32_t idx = 0;
+	// Send characters and end of line.
+	for (idx=0 ; line[idx] != '\0' ; idx++) {
+		AT_fill_rx_buffer((uint8_t) line[idx]);
+	}
+	AT_fill_rx_buffer((uint8_t) '\r');
+}
+
+/* GET THE TOTAL NUMBER OF COMMANDS RECEIVED BY THE VIRTUAL NODES.
+ * @param:	None.
+ * @return:	Number of commands.
+ */
+static uint32_t _SIM_MAIN_get_node_commands(void) {
+	// Local variables.
+	SIM_node_t* node = NULL;
+	uint32_t commands = 0;
+	uint8_t idx = 0;
+	// Nodes loop.
+	for (idx=0 ; (node = SIM_get_node(idx)) != NULL ; idx++) {
+		commands += (node -> commands);
+	}
+	return commands;
+}
+
+/* SEND A LINE PERIODICALLY AND PRINT THE FORWARD AND SNIFFER PATHS STATISTICS.
+ * @param line:			Line to send (without end of line).
+ * @param period_ms:	Sending period.
+ * @param count:		Number of lines.
+ * @return:				None.
+ * Note: host output is not printed during the run, but its FIFO is still simulated.
+ */
+static void _SIM_MAIN_run_rate(char_t* line, uint32_t period_ms, uint32_t count) {
+	// Local variables.
+	SIM_bus_statistics_t bus_start;
+	SIM_bus_statistics_t bus_end;
+	RS485_statistics_t rs485_start;
+	RS485_statistics_t rs485_end;
+	uint32_t commands_start = _SIM_MAIN_get_node_commands();
+	uint64_t start_us = SIM_get_time_us();
+	uint32_t idx = 0;
+	// Read statistics.
+	SIM_get_bus_statistics(&bus_start);
+	RS485_get_statistics(RS485_STATISTICS_BUS, &rs485_start);
+	printf("[%8u ms] > %s (%u lines every %u ms)\n", (uint32_t) (start_us / 1000), line, count, period_ms);
+	USART2_flush();
+	USART2_reset_statistics();
+	// Lines loop.
+	SIM_set_host_output(0);
+	for (idx=0 ; idx<count ; idx++) {
+		_SIM_MAIN_send_line(line);
+		_SIM_MAIN_run_until(start_us + ((uint64_t) (idx + 1) * period_ms * 1000));
+	}
+	SIM_set_host_output(1);
+	// Print statistics.
+	SIM_get_bus_statistics(&bus_end);
+	RS485_get_statistics(RS485_STATISTICS_BUS, &rs485_end);
+	printf("SIM: duration=%ums bus commands=%u frames to DIM=%u lost while transmitting=%u ring dropped=%u sniffed=%u\n",
+		(uint32_t) ((SIM_get_time_us() - start_us) / 1000),
+		_SIM_MAIN_get_node_commands() - commands_start,
+		(bus_end.rx_frames + bus_end.rx_lost_frames) - (bus_start.rx_frames + bus_start.rx_lost_frames),
+		bus_end.rx_lost_frames - bus_start.rx_lost_frames,
+		rs485_end.rx_dropped_frames - rs485_start.rx_dropped_frames,
+		rs485_end.rx_frames - rs485_start.rx_frames);
+	printf("SIM: host FIFO high water mark=%u/%u bytes, dropped=%u bytes\n", USART2_get_tx_high_water_mark(), SIM_USART_TX_BUFFER_SIZE, USART2_get_tx_dropped_bytes());
+}
+
+/* PARSE A BOARD IDENTIFIER.
+ * @param board:	Board name (LVRM, BPSM, ...) or hexadecimal identifier.
+ * @return:			Board identifier, DINFOX_BOARD_ID_ERROR if the name is unknown.
+ */
+static uint8_t _SIM_MAIN_get_board_id(char_t* board) {
+	// Local variables.
+	uint32_t board_id = DINFOX_BOARD_ID_ERROR;
+	uint8_t idx = 0;
+	// Search name.
+	for (idx=0 ; idx<DINFOX_BOARD_ID_LAST ; idx++) {
+		if (strcmp(board, DINFOX_BOARD_ID_NAME[idx]) == 0) return idx;
+	}
+	sscanf(board, "%x", &board_id);
+	return (uint8_t) board_id;
+}
+
+/* EXECUTE A SCENARIO LINE.
+ * @param line:	Line to execute (without end of line).
+ * @return:		None.
+ */
+static void _SIM_MAIN_execute_line(char_t* line) {
+	// Local variables.
+	char_t board[SIM_MAIN_LINE_SIZE_MAX];
+	char_t data[SIM_MAIN_LINE_SIZE_MAX];
+	uint32_t address = 0;
+	uint32_t destination_address = 0;
+	uint32_t latency_ms = 0;
+	uint32_t jitter_ms = 0;
+	uint32_t delay_ms = 0;
+	uint32_t period_ms = 0;
+	uint32_t count = 0;
+	int offset = 0;
+	// Skip empty lines and print comments.
+	if (line[0] == '\0') return;
+	if (line[0] == SIM_MAIN_COMMENT) {
+		printf("%s\n", line);
+		return;
+	}
+	// Virtual node declaration.
+	if (strncmp(line, SIM_MAIN_DIRECTIVE_NODE, strlen(SIM_MAIN_DIRECTIVE_NODE)) == 0) {
+		if ((sscanf(line, SIM_MAIN_DIRECTIVE_NODE " %x %127s %u %u", &address, board, &latency_ms, &jitter_ms) < 3) || (address > RS485_ADDRESS_LAST) || (SIM_add_node((RS485_address_t) address, _SIM_MAIN_get_board_id(board), latency_ms, jitter_ms) == 0)) {
+			printf("SIM: invalid node declaration '%s'\n", line);
+		}
+		return;
+	}
+	// Unsolicited traffic declaration.
+	if (strncmp(line, SIM_MAIN_DIRECTIVE_TRAFFIC, strlen(SIM_MAIN_DIRECTIVE_TRAFFIC)) == 0) {
+		if ((sscanf(line, SIM_MAIN_DIRECTIVE_TRAFFIC " %x %x %u %u %127s", &address, &destination_address, &period_ms, &count, data) < 5) || (address > RS485_ADDRESS_LAST) || (destination_address > RS485_ADDRESS_LAST) || (SIM_add_traffic((RS485_address_t) address, (RS485_address_t) destination_address, period_ms, count, data) == 0)) {
+			printf("SIM: invalid traffic declaration '%s'\n", line);
+		}
+		return;
+	}
+	// Periodic host command.
+	if (strncmp(line, SIM_MAIN_DIRECTIVE_RATE, strlen(SIM_MAIN_DIRECTIVE_RATE)) == 0) {
+		if ((sscanf(line, SIM_MAIN_DIRECTIVE_RATE " %u %u %n", &period_ms, &count, &offset) < 2) || (period_ms == 0) || (offset == 0)) {
+			printf("SIM: invalid rate directive '%s'\n", line);
+			return;
+		}
+		_SIM_MAIN_run_rate(&(line[offset]), period_ms, count);
+		return;
+	}
+	// Idle time (bus frames are still received and printed).
+	if (strncmp(line, SIM_MAIN_DIRECTIVE_WAIT, strlen(SIM_MAIN_DIRECTIVE_WAIT)) == 0) {
+		sscanf(line, SIM_MAIN_DIRECTIVE_WAIT " %u", &delay_ms);
+		_SIM_MAIN_run_until(SIM_get_time_us() + ((uint64_t) delay_ms * 1000));
+		return;
+	}
+	// AT command: send characters through the host interface.
+	printf("[%8u ms] > %s\n", (uint32_t) (SIM_get_time_us() / 1000), line);
+	_SIM_MAIN_send_line(line);
+	_SIM_MAIN_process_events();
+}
+
+/*** SIM MAIN function ***/
+
+/* MAIN FUNCTION.
+ * @param argc:	Number of arguments.
+ * @param argv:	Scenario file (standard input is used if not given).
+ * @return:		0 on success, 1 if the scenario file can not be opened.
+ */
+int main(int argc, char** argv) {
+	// Local variables.
+	FILE* scenario = stdin;
+	char_t line[SIM_MAIN_LINE_SIZE_MAX];
+	SIM_node_t* node = NULL;
+	uint8_t idx = 0;
+	// Open scenario.
+	if (argc > 1) {
+		scenario = fopen(argv[1], "r");
+		if (scenario == NULL) {
+			printf("SIM: can not open %s\n", argv[1]);
+			return 1;
+		}
+	}
+	// Init firmware (same sequence as the firmware main, with blank NVM).
+	ERROR_stack_init();
+#ifdef PROFILING
+	PROF_init();
+#endif
+	NVM_write_byte(NVM_ADDRESS_RS485_ADDRESS, SIM_MAIN_MASTER_ADDRESS);
+	LPUART1_init(SIM_MAIN_MASTER_ADDRESS);
+	CONFIG_init();
+	AT_init();
+	// Execute scenario.
+	while (fgets(line, SIM_MAIN_LINE_SIZE_MAX, scenario) != NULL) {
+		line[strcspn(line, "\r\n")] = '\0';
+		_SIM_MAIN_execute_line(line);
+	}
+	// Print bus summary.
+	printf("SIM: end of scenario at %u ms\n", (uint32_t) (SIM_get_time_us() / 1000));
+	for (idx=0 ; (node = SIM_get_node(idx)) != NULL ; idx++) {
+		printf("SIM: node %02X received %u commands\n", (node -> address), (node -> commands));
+	}
+	if (scenario != stdin) {
+		fclose(scenario);
+	}
+	return 0;
+}
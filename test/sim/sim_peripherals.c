@@ -0,0 +1,323 @@
+/*
+ * sim_peripherals.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "adc.h"
+#include "gpio.h"
+#include "iwdg.h"
+#include "lptim.h"
+#include "nvic.h"
+#include "nvm.h"
+#include "pwr.h"
+#include "rcc_reg.h"
+#include "rtc.h"
+#include "sim.h"
+#include "systick_reg.h"
+#include "types.h"
+#include "usart.h"
+
+#include <stdio.h>
+
+/*** SIM PERIPHERALS local macros ***/
+
+#define SIM_ADC_VMCU_MV			3300
+#define SIM_ADC_VUSB_MV			5000
+#define SIM_ADC_VRS_MV			5000
+#define SIM_ADC_TMCU_DEGREES	25
+#define SIM_USART_BAUD_RATE		9600
+
+/*** SIM PERIPHERALS local structures ***/
+
+typedef struct {
+	// LPTIM.
+	uint64_t timer_start_us;
+	uint64_t timer_end_us;
+	uint8_t timer_running;
+	// NVM.
+	uint8_t nvm[NVM_ADDRESS_LAST];
+	// ADC.
+	uint32_t adc_data_max_age_s;
+	// USART.
+	uint32_t usart_baud_rate;
+	uint64_t usart_tx_end_us;
+	uint32_t usart_tx_high_water_mark;
+	uint32_t usart_tx_dropped_bytes;
+	uint8_t usart_output_enabled;
+#ifdef PWR_STATISTICS
+	// PWR.
+	uint64_t pwr_statistics_start_us;
+#endif
+} SIM_peripherals_context_t;
+
+/*** SIM PERIPHERALS global variables ***/
+
+// Registers read directly by the applicative layer (reset flags: power-on reset).
+RCC_base_address_t sim_rcc = {.CSR = 0x0C000000};
+// Registers used by the profiling module.
+SYSTICK_base_address_t sim_systick;
+
+/*** SIM PERIPHERALS local global variables ***/
+
+static SIM_peripherals_context_t sim_peripherals_ctx = {.adc_data_max_age_s = 60, .usart_baud_rate = SIM_USART_BAUD_RATE, .usart_output_enabled = 1};
+
+/*** ADC functions ***/
+
+ADC_status_t ADC1_perform_measurements(void) {
+	return ADC_SUCCESS;
+}
+
+ADC_status_t ADC1_update_data(uint32_t anticipation_ms) {
+	return ADC_SUCCESS;
+}
+
+ADC_status_t ADC1_set_data_max_age(uint32_t max_age_s) {
+	sim_peripherals_ctx.adc_data_max_age_s = max_age_s;
+	return ADC_SUCCESS;
+}
+
+uint32_t ADC1_get_data_max_age(void) {
+	return sim_peripherals_ctx.adc_data_max_age_s;
+}
+
+ADC_status_t ADC1_get_data_age(uint32_t* data_age_ms) {
+	(*data_age_ms) = 0;
+	return ADC_SUCCESS;
+}
+
+ADC_status_t ADC1_get_data(ADC_data_index_t data_idx, uint32_t* data) {
+	// Local variables.
+	const uint32_t ADC_DATA[ADC_DATA_INDEX_LAST] = {SIM_ADC_VMCU_MV, SIM_ADC_VUSB_MV, SIM_ADC_VRS_MV};
+	// Check parameter.
+	if (data_idx >= ADC_DATA_INDEX_LAST) return ADC_ERROR_DATA_INDEX;
+	(*data) = ADC_DATA[data_idx];
+	return ADC_SUCCESS;
+}
+
+ADC_status_t ADC1_get_tmcu(int8_t* tmcu_degrees) {
+	(*tmcu_degrees) = SIM_ADC_TMCU_DEGREES;
+	return ADC_SUCCESS;
+}
+
+/*** GPIO, IWDG and NVIC functions ***/
+
+void GPIO_configure(const GPIO_pin_t* gpio, GPIO_mode_t mode, GPIO_output_type_t output_type, GPIO_output_speed_t output_speed, GPIO_pull_resistor_t pull_resistor) {
+	// Nothing to do.
+}
+
+uint8_t GPIO_read(const GPIO_pin_t* gpio) {
+	// The only input is the TX mode DIP switch, which is closed (TX enabled).
+	return 0;
+}
+
+void IWDG_reload(void) {
+	// Nothing to do.
+}
+
+void NVIC_enable_interrupt(NVIC_interrupt_t irq_index) {
+	// Nothing to do.
+}
+
+/*** LPTIM functions ***/
+
+LPTIM_status_t LPTIM1_delay_milliseconds(uint32_t delay_ms, uint8_t stop_mode) {
+	// Interrupts are still serviced during the delay.
+	SIM_run_until(SIM_get_time_us() + ((uint64_t) delay_ms * 1000));
+	return LPTIM_SUCCESS;
+}
+
+LPTIM_status_t LPTIM1_start_timer(uint32_t timeout_ms) {
+	sim_peripherals_ctx.timer_start_us = SIM_get_time_us();
+	sim_peripherals_ctx.timer_end_us = sim_peripherals_ctx.timer_start_us + ((uint64_t) timeout_ms * 1000);
+	sim_peripherals_ctx.timer_running = 1;
+	SIM_set_timer(sim_peripherals_ctx.timer_end_us);
+	return LPTIM_SUCCESS;
+}
+
+void LPTIM1_stop_timer(void) {
+	sim_peripherals_ctx.timer_running = 0;
+	SIM_set_timer(SIM_TIME_INFINITE);
+}
+
+uint8_t LPTIM1_get_timer_flag(void) {
+	return ((sim_peripherals_ctx.timer_running != 0) && (SIM_get_time_us() >= sim_peripherals_ctx.timer_end_us)) ? 1 : 0;
+}
+
+uint32_t LPTIM1_get_timer_elapsed_ms(void) {
+	return (uint32_t) ((SIM_get_time_us() - sim_peripherals_ctx.timer_start_us) / 1000);
+}
+
+/*** NVM functions ***/
+
+NVM_status_t NVM_read_byte(NVM_address_t address_offset, uint8_t* data) {
+	if (address_offset >= NVM_ADDRESS_LAST) return NVM_ERROR_ADDRESS;
+	(*data) = sim_peripherals_ctx.nvm[address_offset];
+	return NVM_SUCCESS;
+}
+
+NVM_status_t NVM_write_byte(NVM_address_t address_offset, uint8_t data) {
+	if (address_offset >= NVM_ADDRESS_LAST) return NVM_ERROR_ADDRESS;
+	sim_peripherals_ctx.nvm[address_offset] = data;
+	return NVM_SUCCESS;
+}
+
+NVM_status_t NVM_read_word(NVM_address_t address_offset, uint32_t* data) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Check address.
+	if ((address_offset + 4) > NVM_ADDRESS_LAST) return NVM_ERROR_ADDRESS;
+	// LSB first.
+	(*data) = 0;
+	for (idx=0 ; idx<4 ; idx++) {
+		(*data) |= ((uint32_t) sim_peripherals_ctx.nvm[address_offset + idx]) << (8 * idx);
+	}
+	return NVM_SUCCESS;
+}
+
+NVM_status_t NVM_write_word(NVM_address_t address_offset, uint32_t data) {
+	// Local variables.
+	uint8_t idx = 0;
+	// Check address.
+	if ((address_offset + 4) > NVM_ADDRESS_LAST) return NVM_ERROR_ADDRESS;
+	// LSB first.
+	for (idx=0 ; idx<4 ; idx++) {
+		sim_peripherals_ctx.nvm[address_offset + idx] = (uint8_t) (data >> (8 * idx));
+	}
+	return NVM_SUCCESS;
+}
+
+/*** PWR functions ***/
+
+void PWR_enter_sleep_mode(void) {
+	SIM_wait_for_interrupt();
+}
+
+void PWR_software_reset(void) {
+	printf("SIM: software reset is not simulated\n");
+}
+
+#ifdef PWR_STATISTICS
+void PWR_reset_statistics(void) {
+	sim_peripherals_ctx.pwr_statistics_start_us = SIM_get_time_us();
+}
+
+uint32_t PWR_get_state_time_ms(PWR_state_t state) {
+	// Processing time is not simulated: the core is always sleeping.
+	return (state == PWR_STATE_SLEEP) ? ((uint32_t) ((SIM_get_time_us() - sim_peripherals_ctx.pwr_statistics_start_us) / 1000)) : 0;
+}
+#endif
+
+/*** RTC functions ***/
+
+uint32_t RTC_get_time_ms(void) {
+	return (uint32_t) (SIM_get_time_us() / 1000);
+}
+
+uint32_t RTC_get_time_seconds(void) {
+	return (uint32_t) (SIM_get_time_us() / 1000000);
+}
+
+uint32_t RTC_get_duration_ms(uint32_t start_time_ms, uint32_t end_time_ms) {
+	// Simulated time does not wrap.
+	return (end_time_ms - start_time_ms);
+}
+
+/*** USART functions ***/
+
+void USART2_enable_interrupt(void) {
+	// Nothing to do.
+}
+
+USART_status_t USART2_send_bytes(uint8_t* tx_data, uint32_t tx_data_size) {
+	// Local variables.
+	uint32_t byte_time_us = SIM_get_frame_time_us(1, sim_peripherals_ctx.usart_baud_rate);
+	uint32_t fifo_level = 0;
+	uint32_t idx = 0;
+	// Compute FIFO level from the remaining transmission time.
+	if (sim_peripherals_ctx.usart_tx_end_us < SIM_get_time_us()) {
+		sim_peripherals_ctx.usart_tx_end_us = SIM_get_time_us();
+	}
+	fifo_level = (uint32_t) ((sim_peripherals_ctx.usart_tx_end_us - SIM_get_time_us() + byte_time_us - 1) / byte_time_us);
+	// Check free space (the array is dropped as a whole, as the firmware does).
+	if ((fifo_level + tx_data_size) >= SIM_USART_TX_BUFFER_SIZE) {
+		sim_peripherals_ctx.usart_tx_dropped_bytes += tx_data_size;
+		return USART_ERROR_TX_BUFFER_FULL;
+	}
+	sim_peripherals_ctx.usart_tx_end_us += ((uint64_t) tx_data_size * byte_time_us);
+	if ((fifo_level + tx_data_size) > sim_peripherals_ctx.usart_tx_high_water_mark) {
+		sim_peripherals_ctx.usart_tx_high_water_mark = (fifo_level + tx_data_size);
+	}
+	// Host terminal is the standard output (carriage returns are removed).
+	if (sim_peripherals_ctx.usart_output_enabled == 0) return USART_SUCCESS;
+	for (idx=0 ; idx<tx_data_size ; idx++) {
+		if (tx_data[idx] != '\r') putchar(tx_data[idx]);
+	}
+	return USART_SUCCESS;
+}
+
+USART_status_t USART2_send_string(char_t* tx_string) {
+	// Local variables.
+	uint32_t tx_data_size = 0;
+	// Compute size.
+	while (tx_string[tx_data_size] != '\0') tx_data_size++;
+	return USART2_send_bytes((uint8_t*) tx_string, tx_data_size);
+}
+
+void USART2_flush(void) {
+	// Wait for the end of transmission (interrupts are still serviced).
+	SIM_run_until(sim_peripherals_ctx.usart_tx_end_us);
+	fflush(stdout);
+}
+
+uint32_t USART2_get_tx_high_water_mark(void) {
+	return sim_peripherals_ctx.usart_tx_high_water_mark;
+}
+
+uint32_t USART2_get_tx_dropped_bytes(void) {
+	return sim_peripherals_ctx.usart_tx_dropped_bytes;
+}
+
+uint32_t USART2_get_rx_overruns(void) {
+	return 0;
+}
+
+void USART2_reset_statistics(void) {
+	sim_peripherals_ctx.usart_tx_high_water_mark = 0;
+	sim_peripherals_ctx.usart_tx_dropped_bytes = 0;
+}
+
+USART_status_t USART2_set_baud_rate(uint32_t baud_rate) {
+	if (baud_rate == 0) return USART_ERROR_BAUD_RATE;
+	sim_peripherals_ctx.usart_baud_rate = baud_rate;
+	return USART_SUCCESS;
+}
+
+uint32_t USART2_get_baud_rate(void) {
+	return sim_peripherals_ctx.usart_baud_rate;
+}
+
+USART_baud_rate_status_t USART2_get_baud_rate_status(void) {
+	// Host link is not simulated: baud rate switch is immediate.
+	return USART_BAUD_RATE_STATUS_CONFIRMED;
+}
+
+void USART2_confirm_baud_rate(void) {
+	// Nothing to do.
+}
+
+void USART2_revert_baud_rate(void) {
+	// Nothing to do.
+}
+
+/*** SIM PERIPHERALS functions ***/
+
+/* ENABLE OR DISABLE HOST OUTPUT PRINTING.
+ * @param enabled:	Host output is printed on the standard output when non zero.
+ * @return:			None.
+ * Note: the host link timing and its FIFO statistics are simulated in both cases.
+ */
+void SIM_set_host_output(uint8_t enabled) {
+	sim_peripherals_ctx.usart_output_enabled = enabled;
+}
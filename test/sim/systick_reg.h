@@ -0,0 +1,21 @@
+/*
+ * systick_reg.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SIM_SYSTICK_REG_H__
+#define __SIM_SYSTICK_REG_H__
+
+#include "../../inc/registers/systick_reg.h"
+
+/*** SYSTICK simulated registers ***/
+
+// Registers are mapped on a host variable instead of the peripheral address (counter is frozen since processing time is not simulated).
+extern SYSTICK_base_address_t sim_systick;
+
+#undef SYSTICK
+#define SYSTICK		(&sim_systick)
+
+#endif /* __SIM_SYSTICK_REG_H__ */
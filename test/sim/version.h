@@ -0,0 +1,19 @@
+/*
+ * version.h
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __VERSION_H__
+#define __VERSION_H__
+
+// Fixed version of the simulation build (the firmware one is generated from git by the IDE).
+#define GIT_VERSION			"SIM"
+#define GIT_MAJOR_VERSION	0
+#define GIT_MINOR_VERSION	0
+#define GIT_COMMIT_INDEX	0
+#define GIT_COMMIT_ID		0x00000000
+#define GIT_DIRTY_FLAG		0
+
+#endif /* __VERSION_H__ */
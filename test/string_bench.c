@@ -0,0 +1,228 @@
+/*
+ * string_bench.c
+ *
+ *  Created on: 16 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "math.h"
+#include "string.h"
+#include "types.h"
+
+#include "bench.h"
+
+/*** STRING BENCH macros ***/
+
+#define STRING_BENCH_RANDOM_CASES		600000
+#define STRING_BENCH_ITERATIONS			2000000
+#define STRING_BENCH_BUFFER_SIZE		64
+
+/*** STRING BENCH local functions ***/
+
+/* REFERENCE VALUE TO STRING CONVERSION (FORMER IMPLEMENTATION BASED ON DIVISIONS BY POWERS OF 10).
+ * @param value:        Value to print.
+ * @param format:       Printing format.
+ * @param print_prefix: Print base prefix is non zero.
+ * @param str:       	Output string.
+ * @return status:		Function execution status.
+ */
+static STRING_status_t _STRING_BENCH_reference(int32_t value, STRING_format_t format, uint8_t print_prefix, char_t* str) {
+	// Local variables.
+	STRING_status_t status = STRING_SUCCESS;
+	MATH_status_t math_status = MATH_SUCCESS;
+	uint8_t first_non_zero_found = 0;
+	uint32_t str_idx = 0;
+	uint32_t idx = 0;
+	uint8_t generic_byte = 0;
+	uint8_t nibble = 0;
+	uint32_t current_power = 0;
+	uint32_t previous_decade = 0;
+	uint32_t abs_value = 0;
+	// Manage negative numbers.
+	if (value < 0) {
+		str[str_idx++] = STRING_CHAR_MINUS;
+	}
+	math_status = MATH_abs(value, &abs_value);
+	MATH_status_check(STRING_ERROR_BASE_MATH);
+	switch (format) {
+	case STRING_FORMAT_BOOLEAN:
+		if (print_prefix != 0) {
+			str[str_idx++] = '0';
+			str[str_idx++] = 'b';
+		}
+		for (idx=(MATH_BINARY_MAX_SIZE - 1) ; idx>=0 ; idx--) {
+			if (abs_value & (0b1 << idx)) {
+				str[str_idx++] = '1';
+				first_non_zero_found = 1;
+			}
+			else {
+				if ((first_non_zero_found != 0) || (idx == 0)) {
+					str[str_idx++] = '0';
+				}
+			}
+			if (idx == 0) break;
+		}
+		break;
+	case STRING_FORMAT_HEXADECIMAL:
+		if (print_prefix != 0) {
+			str[str_idx++] = '0';
+			str[str_idx++] = 'x';
+		}
+		for (idx=(MATH_HEXADECIMAL_MAX_SIZE - 1) ; idx>=0 ; idx--) {
+			generic_byte = (abs_value >> (8 * idx)) & 0xFF;
+			if (generic_byte != 0) {
+				first_non_zero_found = 1;
+			}
+			if ((first_non_zero_found != 0) || (idx == 0)) {
+				nibble = ((generic_byte & 0xF0) >> 4);
+				str[str_idx++] = (nibble <= 9 ? (nibble + '0') : (nibble + ('A' - 10)));
+				nibble = (generic_byte & 0x0F);
+				str[str_idx++] = (nibble <= 9 ? (nibble + '0') : (nibble + ('A' - 10)));
+			}
+			if (idx == 0) break;
+		}
+		break;
+	case STRING_FORMAT_DECIMAL:
+		if (print_prefix != 0) {
+			str[str_idx++] = '0';
+			str[str_idx++] = 'd';
+		}
+		for (idx=(MATH_DECIMAL_MAX_SIZE - 1) ; idx>=0 ; idx--) {
+			math_status = MATH_pow_10(idx, &current_power);
+			MATH_status_check(STRING_ERROR_BASE_MATH);
+			generic_byte = (abs_value - previous_decade) / current_power;
+			previous_decade += generic_byte * current_power;
+			if (generic_byte != 0) {
+				first_non_zero_found = 1;
+			}
+			if ((first_non_zero_found != 0) || (idx == 0)) {
+				str[str_idx++] = (generic_byte + '0');
+			}
+			if (idx == 0) break;
+		}
+		break;
+	default:
+		status = STRING_ERROR_FORMAT;
+		goto errors;
+	}
+errors:
+	str[str_idx++] = STRING_CHAR_NULL;
+	return status;
+}
+
+/* COMPARE TWO STRINGS.
+ * @param str_1:	First string.
+ * @param str_2:	Second string.
+ * @return:			1 if both strings are identical, 0 otherwise.
+ */
+static uint8_t _STRING_BENCH_is_equal(char_t* str_1, char_t* str_2) {
+	// Local variables.
+	uint32_t idx = 0;
+	while (str_1[idx] == str_2[idx]) {
+		if (str_1[idx] == STRING_CHAR_NULL) return 1;
+		idx++;
+	}
+	return 0;
+}
+
+/* GET A TEST VALUE (RANDOM VALUES WITH ALL MAGNITUDES AND EDGE CASES).
+ * @param case_idx:	Case index.
+ * @return:			Value to convert.
+ */
+static int32_t _STRING_BENCH_get_value(uint32_t case_idx) {
+	// Local variables.
+	static const int32_t STRING_BENCH_EDGE_VALUES[] = {0, 1, -1, 9, 10, 99, 100, 255, 256, 999999999, 1000000000, 2147483647, -2147483647, (-2147483647 - 1)};
+	uint32_t edge_count = (sizeof(STRING_BENCH_EDGE_VALUES) / sizeof(int32_t));
+	if (case_idx < edge_count) return STRING_BENCH_EDGE_VALUES[case_idx];
+	// Random magnitude so that short values are tested as much as long ones.
+	return (int32_t) (BENCH_random() >> (BENCH_random() % 32));
+}
+
+/* COMPARE FIRMWARE AND REFERENCE CONVERSIONS.
+ * @param:	None.
+ * @return:	Number of mismatches.
+ */
+static uint32_t _STRING_BENCH_check(void) {
+	// Local variables.
+	STRING_format_t format_list[] = {STRING_FORMAT_BOOLEAN, STRING_FORMAT_HEXADECIMAL, STRING_FORMAT_DECIMAL};
+	char_t str_firmware[STRING_BENCH_BUFFER_SIZE];
+	char_t str_reference[STRING_BENCH_BUFFER_SIZE];
+	STRING_status_t status_firmware = STRING_SUCCESS;
+	STRING_status_t status_reference = STRING_SUCCESS;
+	uint32_t mismatches = 0;
+	uint32_t idx = 0;
+	uint8_t format_idx = 0;
+	uint8_t prefix = 0;
+	int32_t value = 0;
+	for (idx=0 ; idx<STRING_BENCH_RANDOM_CASES ; idx++) {
+		value = _STRING_BENCH_get_value(idx);
+		for (format_idx=0 ; format_idx<(sizeof(format_list) / sizeof(STRING_format_t)) ; format_idx++) {
+			for (prefix=0 ; prefix<2 ; prefix++) {
+				status_firmware = STRING_value_to_string(value, format_list[format_idx], prefix, str_firmware);
+				status_reference = _STRING_BENCH_reference(value, format_list[format_idx], prefix, str_reference);
+				if ((status_firmware != status_reference) || (_STRING_BENCH_is_equal(str_firmware, str_reference) == 0)) {
+					if (mismatches < 10) {
+						printf("Mismatch: value=%d format=%u prefix=%u firmware=%s reference=%s\n", value, format_list[format_idx], prefix, str_firmware, str_reference);
+					}
+					mismatches++;
+				}
+			}
+		}
+	}
+	return mismatches;
+}
+
+/* MEASURE FIRMWARE AND REFERENCE CONVERSIONS DURATION.
+ * @param format:		Printing format.
+ * @param value_mask:	Mask applied to random values (sets the typical magnitude).
+ * @return:				None.
+ */
+static void _STRING_BENCH_measure(STRING_format_t format, uint32_t value_mask) {
+	// Local variables.
+	static const char* STRING_BENCH_FORMAT_NAME[STRING_FORMAT_LAST] = {"boolean", "hexadecimal", "decimal"};
+	static int32_t values[256];
+	char_t str[STRING_BENCH_BUFFER_SIZE];
+	uint64_t start_ns = 0;
+	uint64_t reference_ns = 0;
+	uint64_t firmware_ns = 0;
+	uint32_t idx = 0;
+	for (idx=0 ; idx<256 ; idx++) {
+		values[idx] = (int32_t) (BENCH_random() & value_mask);
+	}
+	// Reference implementation.
+	start_ns = BENCH_get_time_ns();
+	for (idx=0 ; idx<STRING_BENCH_ITERATIONS ; idx++) {
+		_STRING_BENCH_reference(values[idx & 0xFF], format, 0, str);
+		bench_sink += (uint32_t) str[0];
+	}
+	reference_ns = BENCH_get_time_ns() - start_ns;
+	// Firmware implementation.
+	start_ns = BENCH_get_time_ns();
+	for (idx=0 ; idx<STRING_BENCH_ITERATIONS ; idx++) {
+		STRING_value_to_string(values[idx & 0xFF], format, 0, str);
+		bench_sink += (uint32_t) str[0];
+	}
+	firmware_ns = BENCH_get_time_ns() - start_ns;
+	printf("%-11s mask=0x%08X : former %6.1f ns, firmware %6.1f ns, speed-up x%.2f\n",
+		STRING_BENCH_FORMAT_NAME[format], value_mask,
+		((double) reference_ns) / STRING_BENCH_ITERATIONS,
+		((double) firmware_ns) / STRING_BENCH_ITERATIONS,
+		((double) reference_ns) / ((double) firmware_ns));
+}
+
+/*** STRING BENCH main function ***/
+
+int main(void) {
+	// Local variables.
+	uint32_t mismatches = 0;
+	// Byte identity check.
+	mismatches = _STRING_BENCH_check();
+	printf("STRING_value_to_string: %u values x 3 formats x 2 prefixes, %u mismatch(es) against former implementation\n", STRING_BENCH_RANDOM_CASES, mismatches);
+	// Duration measurements (register values are mostly short decimal and hexadecimal numbers).
+	_STRING_BENCH_measure(STRING_FORMAT_DECIMAL, 0x00000FFF);
+	_STRING_BENCH_measure(STRING_FORMAT_DECIMAL, 0x7FFFFFFF);
+	_STRING_BENCH_measure(STRING_FORMAT_HEXADECIMAL, 0x000000FF);
+	_STRING_BENCH_measure(STRING_FORMAT_HEXADECIMAL, 0x7FFFFFFF);
+	_STRING_BENCH_measure(STRING_FORMAT_BOOLEAN, 0x000000FF);
+	return (mismatches == 0) ? 0 : 1;
+}